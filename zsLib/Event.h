@@ -45,6 +45,8 @@ namespace zsLib
       Reset_Auto,
     };
 
+    typedef std::vector<EventPtr> EventList;
+
     static EventPtr create(bool manualReset = true);
     static EventPtr create(Resets resets) { return create(resets == Reset_Manual); }
 
@@ -54,5 +56,47 @@ namespace zsLib
     void reset();   // after an event has been notified, reset must be called to cause the wait to happen again
     void wait();    // once an event is notified via "notify()", "wait()" will no longer wait until "reset()" is called
     void notify();  // breaks the wait from executing until the reset is called
+
+    //-------------------------------------------------------------------------
+    // PURPOSE: Wait for the event to be notified but give up after the
+    //          timeout has elapsed (or the time specified has passed).
+    // RETURNS: true if the event was notified, false if the wait timed out.
+    // NOTES:   An auto reset event is consumed by a successful wait.
+    bool waitFor(Microseconds timeout);
+    bool waitUntil(Time timeout);
+
+    template <typename TimeUnit>
+    bool waitFor(TimeUnit timeout) {
+      return waitFor(std::chrono::duration_cast<Microseconds>(timeout));
+    }
+
+    //-------------------------------------------------------------------------
+    // PURPOSE: Wait until any one of the events in the list is notified.
+    // RETURNS: The index of the notified event within the list. Where a
+    //          timeout is specified, false is returned if no event was
+    //          notified before the timeout occured.
+    // NOTES:   Only the event returned is consumed (if it is an auto reset
+    //          event). Other events notified at the same moment remain
+    //          notified and will be returned by a subsequent wait.
+    static size_t waitAny(const EventList &events);
+    static bool waitAnyFor(
+                           const EventList &events,
+                           Microseconds timeout,
+                           size_t *outIndex = NULL
+                           );
+    static bool waitAnyUntil(
+                             const EventList &events,
+                             Time timeout,
+                             size_t *outIndex = NULL
+                             );
+
+    template <typename TimeUnit>
+    static bool waitAnyFor(
+                           const EventList &events,
+                           TimeUnit timeout,
+                           size_t *outIndex = NULL
+                           ) {
+      return waitAnyFor(events, std::chrono::duration_cast<Microseconds>(timeout), outIndex);
+    }
   };
 }
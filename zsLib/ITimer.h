@@ -37,6 +37,11 @@
 
 #define ZSLIB_MAX_TIMER_FIRED_AT_ONCE   5
 
+// The timer monitor reads these settings once (when the first timer is created)
+#define ZSLIB_SETTING_TIMER_MONITOR_THREAD_PRIORITY  "zsLib/timer-monitor/thread-priority"
+#define ZSLIB_SETTING_TIMER_MONITOR_USE_TIMERFD      "zsLib/timer-monitor/use-timerfd"            // Linux only, falls back to a condition variable when unavailable
+#define ZSLIB_SETTING_TIMER_MONITOR_TOTAL_SHARDS     "zsLib/timer-monitor/total-shards"           // number of independent timer monitor threads
+
 namespace zsLib
 {
   ZS_DECLARE_INTERACTION_PROXY(ITimerDelegate);
@@ -54,11 +59,19 @@ namespace zsLib
     //          and missed many events. To fire off hundreds of events at once
     //          is not desirable behaviour so a limit is put which is specified
     //          with "maxFiringTimerAtOnce" to prevent timer wakeup floods.
+    //
+    //          The "tolerance" is how late the timer is allowed to fire
+    //          beyond its scheduled time. Timers with a tolerance allow the
+    //          timer monitor to fire many timers expiring near each other
+    //          in a single wake-up rather than waking for each individually.
+    //          A repeating timer does not drift as each firing is scheduled
+    //          from the previous scheduled time (not the actual fire time).
     static ITimerPtr create(
                             ITimerDelegatePtr delegate,
                             Microseconds timeout,
                             bool repeat = true,
-                            size_t maxFiringTimerAtOnce = ZSLIB_MAX_TIMER_FIRED_AT_ONCE
+                            size_t maxFiringTimerAtOnce = ZSLIB_MAX_TIMER_FIRED_AT_ONCE,
+                            Microseconds tolerance = Microseconds()
                             );
 
     //-------------------------------------------------------------------------
@@ -69,16 +82,31 @@ namespace zsLib
                             ITimerDelegatePtr delegate,
                             TimeUnit timeout,
                             bool repeat = true,
-                            size_t maxFiringTimerAtOnce = ZSLIB_MAX_TIMER_FIRED_AT_ONCE
+                            size_t maxFiringTimerAtOnce = ZSLIB_MAX_TIMER_FIRED_AT_ONCE,
+                            Microseconds tolerance = Microseconds()
                             ) {
-      return create(delegate, std::chrono::duration_cast<Microseconds>(timeout), repeat, maxFiringTimerAtOnce);
+      return create(delegate, std::chrono::duration_cast<Microseconds>(timeout), repeat, maxFiringTimerAtOnce, tolerance);
     }
 
     //-------------------------------------------------------------------------
     // PURPOSE: Helper creation routine to timeout at a specific moment in time
+    // NOTES:   Timers are scheduled against the monotonic clock. The wall
+    //          clock time is converted once when the timer is created thus
+    //          later adjustments to the wall clock do not affect when the
+    //          timer fires.
+    static ITimerPtr create(
+                            ITimerDelegatePtr delegate,
+                            Time timeout,
+                            Microseconds tolerance = Microseconds()
+                            );
+
+    //-------------------------------------------------------------------------
+    // PURPOSE: Helper creation routine to timeout at a specific moment in
+    //          monotonic time
     static ITimerPtr create(
                             ITimerDelegatePtr delegate,
-                            Time timeout
+                            SteadyTime timeout,
+                            Microseconds tolerance = Microseconds()
                             );
 
     virtual PUID getID() const = 0;
@@ -32,15 +32,27 @@
 #pragma once
 
 #include <zsLib/internal/zsLib_Socket.h>
+#include <zsLib/IPAddress.h>
+
+#include <list>
+#include <vector>
 
 #pragma warning(push)
 #pragma warning(disable: 4290)
 
 #define ZSLIB_SETTING_SOCKET_MONITOR_THREAD_PRIORITY "zsLib/socket-monitor/thread-priority"
+#define ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL       "zsLib/socket-monitor/use-epoll"
+#define ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS  "zsLib/socket-monitor/total-reactors"        // 0 = grow/shrink monitors on demand, otherwise a fixed number of monitor threads
+#define ZSLIB_SETTING_SOCKET_MONITOR_ASSIGNMENT      "zsLib/socket-monitor/reactor-assignment"    // "load" or "hash"
+#define ZSLIB_SETTING_SOCKET_MONITOR_DISABLE_EVENTFD "zsLib/socket-monitor/disable-eventfd"       // true wakes monitors through a pipe instead (as where eventfd is unavailable)
+
+#define ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE       "zsLib/socket-completion/engine"             // "io_uring" (falls back to "readiness" when unavailable) or "readiness"
+#define ZSLIB_SETTING_SOCKET_COMPLETION_QUEUE_DEPTH  "zsLib/socket-completion/queue-depth"        // io_uring submission queue entries
 
 namespace zsLib
 {
   ZS_DECLARE_INTERACTION_PROXY(ISocketDelegate)
+  ZS_DECLARE_INTERACTION_PROXY(ISocketCompletionDelegate)
 
   class Socket  : public internal::Socket
   {
@@ -93,8 +105,9 @@ namespace zsLib
 
     struct Send {
       enum Options {
-        None = 0,
-        OOB  = MSG_OOB
+        None     = 0,
+        OOB      = MSG_OOB,
+        ZeroCopy = MSG_ZEROCOPY,   // requires SetOptionFlag::ZeroCopy; the buffer must stay untouched until ISocketDelegate::onZeroCopyCompleted
       };
     };
 
@@ -116,10 +129,14 @@ namespace zsLib
         KeepAlive            = SO_KEEPALIVE,
         OOBInLine            = SO_OOBINLINE,
         ReuseAddress         = SO_REUSEADDR,
+        ReusePort            = SO_REUSEPORT,  // many sockets may bind the same address and the kernel spreads the load across them
         BSDState             = SO_WINDOWS_BSD_STATE,
         ConditionalAccept    = SO_WINDOWS_CONDITIONAL_ACCEPT,
         ExclusiveAddressUse  = SO_WINDOWS_EXCLUSIVEADDRUSE,
         TCPNoDelay           = TCP_NODELAY,
+        ZeroCopy             = SO_ZEROCOPY,
+        UDPReceiveCoalescing = UDP_GRO,       // receiveFromCoalesced may return many datagrams from one sender in a single buffer
+        PreferBusyPoll       = SO_PREFER_BUSY_POLL, // keep device interrupts deferred while the socket is busy polled
       };
     };
 
@@ -128,6 +145,9 @@ namespace zsLib
         ReceiverBufferSizeInBytes = SO_RCVBUF,
         SendBufferSizeInBytes     = SO_SNDBUF,
         LingerTimeInSeconds       = SO_LINGER, // specifying a time of 0 will disable linger
+        UDPSegmentSizeInBytes     = UDP_SEGMENT, // every sendTo is split into datagrams of this size by the kernel (0 = disabled)
+        IncomingCPU               = SO_INCOMING_CPU, // prefer this listener for connections arriving on the CPU (SO_REUSEPORT groups)
+        BusyPollInMicroseconds    = SO_BUSY_POLL, // receives poll the device queue for this long before sleeping (raising it may require CAP_NET_ADMIN)
       };
     };
 
@@ -140,11 +160,14 @@ namespace zsLib
         IsKeepAlive             = SO_KEEPALIVE,
         IsOOBInLine             = SO_OOBINLINE,
         IsReuseAddress          = SO_REUSEADDR,
+        IsReusePort             = SO_REUSEPORT,
         IsOOBAllRead            = SIOCATMARK,
         IsConditionalAccept     = SO_WINDOWS_CONDITIONAL_ACCEPT,
         IsLingering             = SO_WINDOWS_DONTLINGER,
         IsExclusiveAddressUse   = SO_EXCLUSIVEADDRUSE,
         IsTCPNoDelay            = TCP_NODELAY,
+        IsUDPReceiveCoalescing  = UDP_GRO,
+        IsPreferBusyPoll        = SO_PREFER_BUSY_POLL,
       };
     };
 
@@ -155,7 +178,10 @@ namespace zsLib
         SendBufferSizeInBytes      = SO_SNDBUF,
         ReadyToReadSizeInBytes     = FIONREAD,    // how much data is available in a single recv method for stream types (more data may be pending), or how much data is in the buffer total for message oriented socket (however read will return the message size even if more data is available)
         Type                       = SO_TYPE,
-        MaxMessageSizeInBytes      = SO_WINDOWS_MAX_MSG_SIZE
+        MaxMessageSizeInBytes      = SO_WINDOWS_MAX_MSG_SIZE,
+        UDPSegmentSizeInBytes      = UDP_SEGMENT,
+        IncomingCPU                = SO_INCOMING_CPU,
+        BusyPollInMicroseconds     = SO_BUSY_POLL
       };
     };
 
@@ -166,13 +192,99 @@ namespace zsLib
         Exception = 0x04,
         
         All       = (Read | Write | Exception),
+
+        // Readiness stays armed after a notification and the delegate is
+        // notified again only once new data (or space) arrives. The delegate
+        // must read (or write) until the operation would block. When the
+        // monitor cannot use edge triggered events, the read (or write)
+        // interest is re-armed only when an operation would block.
+        EdgeTriggered = 0x08,
+
+        // Read readiness is handled on the monitor thread by receiving into a
+        // buffer drawn from the shared receive pool, which is delivered to
+        // ISocketDelegate::onDataReceived instead of calling onReadReady.
+        // Idle sockets hold no receive buffer.
+        ReceiveIntoPool = 0x10,
       };
     };
 
+    struct MonitorLoad {
+      PUID mMonitorID {};
+      bool mReactor {};                 // true if the monitor is one of the fixed reactors
+      size_t mTotalSockets {};          // sockets currently assigned to the monitor
+      size_t mTotalWaits {};            // number of times the monitor has waited for events
+      size_t mTotalEvents {};           // number of socket events the monitor has fired
+      size_t mTotalActiveWaits {};      // waits that fired at least one socket (events per wake = mTotalEvents / mTotalActiveWaits)
+      size_t mMaxEventsPerWait {};      // most sockets fired by a single wait
+      size_t mTotalRebuilds {};         // times the poll set was rebuilt after registrations changed
+      size_t mTotalWakeUps {};          // wake-ups signalled to the monitor thread (requests made while one is pending are coalesced)
+      bool mBusyPoll {};                // true if the monitor spins rather than sleeping (see setBusyPoll)
+      int mBusyPollCPU {-1};            // CPU the busy poll thread is pinned to or -1 if not pinned
+      size_t mTotalSpinWaits {};        // waits that returned immediately rather than sleeping
+      Microseconds mThreadCPUTime {};   // CPU consumed by the monitor thread (CPU cost = mThreadCPUTime / mThreadRunTime)
+      Microseconds mThreadRunTime {};   // time since the monitor thread started
+    };
+    typedef std::list<MonitorLoad> MonitorLoadList;
+
+    struct BusyPollOptions {
+      Microseconds mKernelBusyPoll {50};  // SetOptionValue::BusyPollInMicroseconds applied to the socket (0 = leave as is)
+      int mCPU {-1};                      // pin the busy poll thread to this CPU (-1 = not pinned)
+      Microseconds mSpinTimeout {};       // sleep once no socket has fired for this long (0 = always spin)
+    };
+
+    struct DatagramBuffer {
+      IPAddress mAddress;               // remote address on receive, destination on send
+      BYTE *mBuffer {};
+      size_t mBufferLengthInBytes {};   // buffer capacity on receive, datagram length on send
+      size_t mLengthInBytes {};         // bytes received or sent
+      int mError {};                    // 0 on success, otherwise the socket error for this datagram
+    };
+
+    // Counters accumulated since the socket was created. Counting is always on
+    // and costs an atomic increment per event.
+    struct Statistics {
+      size_t mBytesReceived {};
+      size_t mBytesSent {};
+      size_t mPacketsReceived {};       // datagrams, or stream receives that returned data
+      size_t mPacketsSent {};           // datagrams (segments), or stream sends that accepted data
+      size_t mSystemCalls {};           // I/O system calls issued
+      size_t mWouldBlocks {};           // I/O system calls that would have blocked
+      size_t mErrors {};                // I/O system calls that failed for any other reason
+      size_t mReadReadyNotifications {};
+      size_t mWriteReadyNotifications {};
+      size_t mExceptionNotifications {};
+      size_t mRearms {};                // interest re-armed with the socket monitor
+      size_t mAccepted {};              // connections accepted
+    };
+
+    struct BufferSpan {
+      BYTE *mBuffer {};
+      size_t mLengthInBytes {};
+    };
+
+    struct AcceptedSocket {
+      SocketPtr mSocket;
+      IPAddress mRemoteIP;
+    };
+    typedef std::list<AcceptedSocket> AcceptedSocketList;
+
+    // applied to every socket returned from acceptBatch
+    struct AcceptOptions {
+      bool mNonBlocking {true};
+      bool mTCPNoDelay {};
+      bool mKeepAlive {};
+      ULONG mReceiveBufferSizeInBytes {};   // 0 = system default
+      ULONG mSendBufferSizeInBytes {};      // 0 = system default
+    };
+
   public:
     static void ignoreSIGPIPEOnThisThread();
 
+    static MonitorLoadList getMonitorLoads();                           // the loop counters are also traced (SocketMonitorStatistics event) when a monitor shuts down
+
     static SocketPtr create() throw(Exceptions::Unspecified);
+
+    static SocketBufferPtr createBuffer(size_t inSizeInBytes);   // draws a buffer of at least the size from the shared receive pool
     static SocketPtr createUDP(Create::Family inFamily = Create::IPv4) throw(Exceptions::Unspecified);
     static SocketPtr createTCP(Create::Family inFamily = Create::IPv4) throw(Exceptions::Unspecified);
     static SocketPtr create(Create::Family inFamily, Create::Type inType, Create::Protocol inProtocol) throw(Exceptions::Unspecified);
@@ -188,10 +300,59 @@ namespace zsLib
 
     virtual bool isValid() const;
 
+    virtual Statistics getStatistics() const;                             // the counters are also traced (SocketStatistics event) when the socket closes
+
     // socket must be valid in order to monitor the socket or an exception will be thrown
     virtual void setDelegate(ISocketDelegatePtr delegate = ISocketDelegatePtr()) throw (Exceptions::InvalidSocket);
+
+    // The delegate is invoked inline on the socket monitor thread rather than
+    // through a proxy posting to its message queue. Handlers must never block
+    // and must not call setDelegate(), setDirectDelegate() or monitor() on a
+    // monitored socket as those wait for the monitor thread. Closing the
+    // socket (or releasing the last reference to it) from a handler is safe.
+    // A handler which throws is treated as a gone delegate and the socket is
+    // no longer monitored. Only a weak reference to the delegate is held.
+    virtual void setDirectDelegate(ISocketDelegatePtr delegate = ISocketDelegatePtr()) throw (Exceptions::InvalidSocket);
     virtual void monitor(Monitor::Options options = Monitor::All);
 
+    // The socket monitor notifies ISocketDelegate::onIdleTimeout after the
+    // monitored socket has had no readiness events for the timeout. Idle
+    // sockets are found lazily by the monitor thread thus a notification
+    // may arrive up to an eighth of the timeout late. A zero timeout disables.
+    virtual void setIdleTimeout(Milliseconds timeout = Milliseconds());
+    virtual Milliseconds getIdleTimeout() const;
+
+    // Moves the socket to a busy poll monitor whose thread spins on its
+    // sockets instead of sleeping, removing the wake-up latency at the cost
+    // of a CPU core (see MonitorLoad::mThreadCPUTime). Must be called before
+    // a delegate is set. Pair with setDirectDelegate() and
+    // Monitor::ReceiveIntoPool so datagrams are received and delivered on the
+    // spinning thread. Sockets asking for the same CPU share one thread.
+    virtual void setBusyPoll(const BusyPollOptions &options) throw (Exceptions::InvalidSocket);
+
+    // Completion based I/O: operations are submitted with a buffer and their
+    // results are delivered to the completion delegate on its message queue.
+    // The engine is chosen by ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE when the
+    // delegate is first set. Buffers must stay valid until the completion is
+    // delivered. A socket should use either completion or readiness
+    // (setDelegate) based I/O but not both.
+    virtual void setCompletionDelegate(ISocketCompletionDelegatePtr delegate = ISocketCompletionDelegatePtr()) throw (Exceptions::InvalidSocket);
+    virtual String getCompletionEngineName() const;
+
+    virtual PUID submitReceive(
+                               BYTE *ioBuffer,
+                               size_t inBufferLengthInBytes,
+                               ULONG flags = (ULONG)(Receive::None)
+                               ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet);
+    virtual PUID submitSend(
+                            const BYTE *inBuffer,
+                            size_t inBufferLengthInBytes,
+                            ULONG flags = (ULONG)(Send::None)
+                            ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet);
+    virtual PUID submitAccept() throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet);
+
+    virtual void cancelSubmitted();                                       // outstanding operations complete with ECANCELED
+
     virtual void close() throw(Exceptions::WouldBlock, Exceptions::Unspecified);  // closing a socket will automaticlaly remove any socket monitor
 
     virtual IPAddress getLocalAddress() const throw (Exceptions::InvalidSocket, Exceptions::Unspecified);
@@ -222,6 +383,28 @@ namespace zsLib
                                            Exceptions::Unspecified
                                            );
 
+    // Accepts pending connections until none remain (or inMaxSockets have
+    // been accepted when non-zero) and appends them to outSockets. Where
+    // supported the non-blocking and close-on-exec flags are set by the
+    // accept itself; the remaining options are applied per socket. The
+    // listening socket is re-armed once per batch. A blocking listener
+    // waits for the first connection only and returns after accepting it.
+    // A socket whose options cannot be applied is still returned. An error
+    // after some connections were accepted does not throw but is returned
+    // through noThrowErrorResult (if used). Returns the number of sockets
+    // accepted.
+    virtual size_t acceptBatch(
+                               AcceptedSocketList &outSockets,
+                               const AcceptOptions *inOptions = NULL,   // NULL = AcceptOptions defaults
+                               size_t inMaxSockets = 0,
+                               bool *outWouldBlock = NULL,
+                               int *noThrowErrorResult = NULL
+                               ) const throw(
+                                             Exceptions::InvalidSocket,
+                                             Exceptions::ConnectionReset,
+                                             Exceptions::Unspecified
+                                             );
+
     virtual void connect(
                          const IPAddress &inDestination,     // destination of the connection
                          bool *outWouldBlock = NULL,         // if this param is used, will return the "would block" as a result rather than throwing an exception
@@ -270,6 +453,24 @@ namespace zsLib
                                              Exceptions::Unspecified
                                              );
 
+    // receives into each buffer span in order (scatter), at most 64 spans per call
+    virtual size_t receiveVectored(
+                                   const BufferSpan *ioBuffers,
+                                   size_t inTotalBuffers,
+                                   bool *outWouldBlock = NULL,         // if this param is used, will return the "would block" as a result rather than throwing an exception
+                                   ULONG flags = (ULONG)(Receive::None),
+                                   int *noThrowErrorResult = NULL
+                                   ) const throw(
+                                                 Exceptions::InvalidSocket,
+                                                 Exceptions::WouldBlock,
+                                                 Exceptions::Shutdown,
+                                                 Exceptions::ConnectionReset,
+                                                 Exceptions::ConnectionAborted,
+                                                 Exceptions::Timeout,
+                                                 Exceptions::BufferTooSmall,
+                                                 Exceptions::Unspecified
+                                                 );
+
     virtual size_t send(
                         const BYTE *inBuffer,
                         size_t inBufferLengthInBytes,
@@ -288,6 +489,47 @@ namespace zsLib
                                       Exceptions::Unspecified
                                       );
 
+    // sends each buffer span in order (gather) as if they were one contiguous
+    // buffer, at most 64 spans per call
+    virtual size_t sendVectored(
+                                const BufferSpan *inBuffers,
+                                size_t inTotalBuffers,
+                                bool *outWouldBlock = NULL,         // if this param is used, will return the "would block" as a result rather than throwing an exception
+                                ULONG flags = (ULONG)(Send::None),
+                                int *noThrowErrorResult = NULL
+                                ) const throw(
+                                              Exceptions::InvalidSocket,
+                                              Exceptions::WouldBlock,
+                                              Exceptions::Shutdown,
+                                              Exceptions::HostNotReachable,
+                                              Exceptions::ConnectionAborted,
+                                              Exceptions::ConnectionReset,
+                                              Exceptions::Timeout,
+                                              Exceptions::BufferTooSmall,
+                                              Exceptions::Unspecified
+                                              );
+
+    // sends up to inLengthInBytes from the file starting at inOffset without
+    // copying through user space where the platform supports it; returns the
+    // number of bytes sent which may be less than requested
+    virtual size_t sendFile(
+                            int inFileDescriptor,
+                            uint64_t inOffset,
+                            size_t inLengthInBytes,
+                            bool *outWouldBlock = NULL,         // if this param is used, will return the "would block" as a result rather than throwing an exception
+                            int *noThrowErrorResult = NULL
+                            ) const throw(
+                                          Exceptions::InvalidSocket,
+                                          Exceptions::WouldBlock,
+                                          Exceptions::Shutdown,
+                                          Exceptions::HostNotReachable,
+                                          Exceptions::ConnectionAborted,
+                                          Exceptions::ConnectionReset,
+                                          Exceptions::Timeout,
+                                          Exceptions::BufferTooSmall,
+                                          Exceptions::Unspecified
+                                          );
+
     virtual size_t sendTo(
                           const IPAddress &inDestination,
                           const BYTE *inBuffer,
@@ -308,6 +550,94 @@ namespace zsLib
                                         Exceptions::Unspecified
                                         );
 
+    // Receives up to inTotalDatagrams datagrams with as few system calls as
+    // possible. Returns how many datagrams were received. The batch stops at
+    // the first datagram that fails (its mError is set) or once no more
+    // datagrams are pending. A blocking socket only waits for the first
+    // datagram. outWouldBlock is set only when the system reported that the
+    // socket would block, thus a short batch does not imply the socket was
+    // drained. A datagram truncated to fit its buffer is still received but
+    // reports WSAEMSGSIZE. Only an invalid socket throws.
+    virtual size_t receiveFromBatch(
+                                    DatagramBuffer *ioDatagrams,
+                                    size_t inTotalDatagrams,
+                                    bool *outWouldBlock = NULL,
+                                    ULONG flags = (ULONG)(Receive::None)
+                                    ) const throw(Exceptions::InvalidSocket);
+
+    // Sends up to inTotalDatagrams datagrams with as few system calls as
+    // possible. Returns how many datagrams were sent. The batch stops at the
+    // first datagram that fails (its mError is set) or once the socket would
+    // block, in which case outWouldBlock is set. Only an invalid socket throws.
+    virtual size_t sendToBatch(
+                               DatagramBuffer *ioDatagrams,
+                               size_t inTotalDatagrams,
+                               bool *outWouldBlock = NULL,
+                               ULONG flags = (ULONG)(Send::None)
+                               ) const throw(Exceptions::InvalidSocket);
+
+    // Sends the buffer as consecutive datagrams of inSegmentSizeInBytes (the
+    // last may be shorter) with a single system call using UDP segmentation
+    // offload where supported, otherwise one datagram at a time. At most 64
+    // segments and 64KB may be sent per call. Returns the bytes sent.
+    virtual size_t sendToSegmented(
+                                   const IPAddress &inDestination,
+                                   const BYTE *inBuffer,
+                                   size_t inBufferLengthInBytes,
+                                   size_t inSegmentSizeInBytes,
+                                   bool *outWouldBlock = NULL,         // if this param is used, will return the "would block" as a result rather than throwing an exception
+                                   ULONG flags = (ULONG)(Send::None),
+                                   int *noThrowErrorResult = NULL
+                                   ) const throw(
+                                                 Exceptions::InvalidSocket,
+                                                 Exceptions::WouldBlock,
+                                                 Exceptions::Shutdown,
+                                                 Exceptions::HostNotReachable,
+                                                 Exceptions::ConnectionAborted,
+                                                 Exceptions::ConnectionReset,
+                                                 Exceptions::Timeout,
+                                                 Exceptions::BufferTooSmall,
+                                                 Exceptions::Unspecified
+                                                 );
+
+    // Receives a buffer which may hold several datagrams from the same sender
+    // when SetOptionFlag::UDPReceiveCoalescing is enabled; each datagram is
+    // outSegmentSizeInBytes long except possibly the last (see splitSegments).
+    // Without coalescing a single datagram is received and its length is the
+    // segment size. The buffer should be 64KB to hold a full coalesced read.
+    virtual size_t receiveFromCoalesced(
+                                        IPAddress &outRemoteIP,
+                                        BYTE *ioBuffer,
+                                        size_t inBufferLengthInBytes,
+                                        size_t &outSegmentSizeInBytes,
+                                        bool *outWouldBlock = NULL,    // if this param is used, will return the "would block" as a result rather than throwing an exception
+                                        ULONG flags = (ULONG)(Receive::None),
+                                        int *noThrowErrorResult = NULL
+                                        ) const throw(
+                                                      Exceptions::InvalidSocket,
+                                                      Exceptions::WouldBlock,
+                                                      Exceptions::Shutdown,
+                                                      Exceptions::ConnectionReset,
+                                                      Exceptions::Timeout,
+                                                      Exceptions::BufferTooSmall,
+                                                      Exceptions::Unspecified
+                                                      );
+
+    static size_t getTotalSegments(
+                                   size_t inLengthInBytes,
+                                   size_t inSegmentSizeInBytes
+                                   );
+
+    // fills outSegments with the datagrams held in a coalesced buffer and
+    // returns how many were filled (never more than inMaxSegments)
+    static size_t splitSegments(
+                                BYTE *inBuffer,
+                                size_t inLengthInBytes,
+                                size_t inSegmentSizeInBytes,
+                                BufferSpan *outSegments,
+                                size_t inMaxSegments
+                                );
+
     virtual void shutdown(Shutdown::Options inOptions = Shutdown::Both) const throw(Exceptions::InvalidSocket, Exceptions::Unspecified);
 
     virtual void setBlocking(bool enabled) const throw(Exceptions::InvalidSocket, Exceptions::Unspecified) {setOptionFlag(SetOptionFlag::NonBlocking, !enabled);}
@@ -323,17 +653,148 @@ namespace zsLib
     virtual void onExceptionReset() const throw(Exceptions::DelegateNotSet, Exceptions::InvalidSocket, Exceptions::Unspecified);
 
   protected:
+    friend class SocketShardedListener;
+
     Socket() throw(Exceptions::Unspecified);
 
+    void attachDelegate(ISocketDelegatePtr delegate);
+
+    PUID submitOperation(
+                         int operationType,
+                         BYTE *buffer,
+                         size_t bufferLengthInBytes,
+                         ULONG flags
+                         ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet);
+
   protected:
     SOCKET mSocket;
   };
 
+  // A buffer drawn from the shared, size classed receive pool. Its storage is
+  // recycled into the pool once the last reference is released.
+  struct SocketBuffer
+  {
+    BYTE *mBuffer {};
+    size_t mLengthInBytes {};         // bytes received
+    size_t mCapacityInBytes {};       // size class of the storage
+    IPAddress mRemoteIP;              // sender of a datagram
+    int mError {};                    // receive error (the buffer is empty)
+
+    SocketBuffer() {}
+    SocketBuffer(const SocketBuffer &) = delete;
+    ~SocketBuffer();
+  };
+
+  // TCP listeners sharing one address through SetOptionFlag::ReusePort so
+  // the kernel spreads incoming connections across them. Every shard is
+  // linked to its own socket monitor (the fixed reactors round robin when
+  // configured) and should be given a delegate on its own message queue so
+  // accepts scale with cores.
+  class SocketShardedListener
+  {
+  public:
+    struct Shard {
+      size_t mIndex {};
+      SocketPtr mSocket;
+      PUID mMonitorID {};
+      int mIncomingCPU {-1};            // CPU steered to this shard or -1 if not steered
+      size_t mTotalAccepted {};         // connections accepted from this shard
+    };
+    typedef std::list<Shard> ShardList;
+
+  protected:
+    SocketShardedListener() {}
+    SocketShardedListener(const SocketShardedListener &) = delete;
+
+  public:
+    ~SocketShardedListener();
+
+    static SocketShardedListenerPtr create(
+                                           const IPAddress &inBindIP,              // port 0 binds all shards to the port chosen for the first shard
+                                           size_t inTotalShards = 0,               // 0 = one shard per hardware thread
+                                           bool inSteerIncomingCPU = false         // shard N prefers connections arriving on CPU N (SetOptionValue::IncomingCPU)
+                                           ) throw (
+                                                    Socket::Exceptions::AddressInUse,
+                                                    Socket::Exceptions::UnsupportedSocketOption,
+                                                    Socket::Exceptions::Unspecified
+                                                    );
+
+    size_t getTotalShards() const {return mShards.size();}
+    SocketPtr getShard(size_t inIndex) const;
+    IPAddress getLocalAddress() const {return mLocalAddress;}
+
+    void setDelegate(
+                     size_t inIndex,
+                     ISocketDelegatePtr delegate = ISocketDelegatePtr()
+                     ) throw (Socket::Exceptions::InvalidSocket);
+
+    ShardList getShards() const;
+    size_t getTotalAccepted() const;
+
+    void close();
+
+  protected:
+    std::vector<SocketPtr> mShards;
+    std::vector<int> mIncomingCPUs;
+    IPAddress mLocalAddress;
+  };
+
   interaction ISocketDelegate
   {
     virtual void onReadReady(SocketPtr socket) = 0;
     virtual void onWriteReady(SocketPtr socket) = 0;
     virtual void onException(SocketPtr socket) = 0;
+
+    // Send::ZeroCopy sends numbered firstSendID to lastSendID (counted from
+    // 0 per socket) have completed and their buffers may be reused; copied is
+    // true if the kernel fell back to copying the data.
+    virtual void onZeroCopyCompleted(
+                                     SocketPtr /*socket*/,
+                                     ULONG /*firstSendID*/,
+                                     ULONG /*lastSendID*/,
+                                     bool /*copied*/
+                                     ) {}
+
+    // Called instead of onReadReady for sockets monitored with
+    // Monitor::ReceiveIntoPool. An empty buffer from a stream socket means
+    // the connection was closed (or failed if mError is set) and no further
+    // data follows.
+    virtual void onDataReceived(
+                                SocketPtr /*socket*/,
+                                SocketBufferPtr /*buffer*/
+                                ) {}
+
+    // The socket had no readiness events for its Socket::setIdleTimeout()
+    // period. Repeats once per period for as long as the socket stays idle.
+    virtual void onIdleTimeout(SocketPtr /*socket*/) {}
+  };
+
+  interaction ISocketCompletionDelegate
+  {
+    // error is 0 on success, otherwise the socket error (ECANCELED if the
+    // operation was cancelled); a receive of 0 bytes without an error means
+    // the connection was closed
+    virtual void onSocketReceiveCompleted(
+                                          SocketPtr socket,
+                                          PUID operationID,
+                                          BYTE *buffer,
+                                          size_t bytesReceived,
+                                          int error
+                                          ) = 0;
+    virtual void onSocketSendCompleted(
+                                       SocketPtr socket,
+                                       PUID operationID,
+                                       const BYTE *buffer,
+                                       size_t bytesSent,
+                                       int error
+                                       ) = 0;
+    virtual void onSocketAcceptCompleted(
+                                         SocketPtr socket,
+                                         PUID operationID,
+                                         SocketPtr acceptedSocket,
+                                         IPAddress remoteIP,
+                                         int error
+                                         ) = 0;
   };
 }
 
@@ -341,7 +802,19 @@ namespace zsLib
 
 ZS_DECLARE_PROXY_BEGIN(zsLib::ISocketDelegate)
 ZS_DECLARE_PROXY_TYPEDEF(zsLib::SocketPtr, SocketPtr)
+ZS_DECLARE_PROXY_TYPEDEF(zsLib::SocketBufferPtr, SocketBufferPtr)
 ZS_DECLARE_PROXY_METHOD_1(onReadReady, SocketPtr)
 ZS_DECLARE_PROXY_METHOD_1(onWriteReady, SocketPtr)
 ZS_DECLARE_PROXY_METHOD_1(onException, SocketPtr)
+ZS_DECLARE_PROXY_METHOD_4(onZeroCopyCompleted, SocketPtr, ULONG, ULONG, bool)
+ZS_DECLARE_PROXY_METHOD_2(onDataReceived, SocketPtr, SocketBufferPtr)
+ZS_DECLARE_PROXY_METHOD_1(onIdleTimeout, SocketPtr)
+ZS_DECLARE_PROXY_END()
+
+ZS_DECLARE_PROXY_BEGIN(zsLib::ISocketCompletionDelegate)
+ZS_DECLARE_PROXY_TYPEDEF(zsLib::SocketPtr, SocketPtr)
+ZS_DECLARE_PROXY_TYPEDEF(zsLib::IPAddress, IPAddress)
+ZS_DECLARE_PROXY_METHOD_5(onSocketReceiveCompleted, SocketPtr, PUID, BYTE *, size_t, int)
+ZS_DECLARE_PROXY_METHOD_5(onSocketSendCompleted, SocketPtr, PUID, const BYTE *, size_t, int)
+ZS_DECLARE_PROXY_METHOD_5(onSocketAcceptCompleted, SocketPtr, PUID, SocketPtr, IPAddress, int)
 ZS_DECLARE_PROXY_END()
@@ -33,7 +33,7 @@
 #include <zsLib/helpers.h>
 #include <zsLib/Exception.h>
 
-//namespace zsLib {ZS_DECLARE_SUBSYSTEM(zsLib)}
+namespace zsLib {ZS_DECLARE_SUBSYSTEM(zsLib)}
 
 namespace zsLib
 {
@@ -61,6 +61,143 @@ namespace zsLib
 #endif //_WIN32
     }
 
+#ifndef ZSLIB_INTERNAL_USE_WIN32_EVENT
+    //-------------------------------------------------------------------------
+    bool Event::consume()
+    {
+      // NOTE: must be called from within mMutex
+      if (!mNotified) return false;
+      if (!mManualReset) mNotified = false;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void Event::addWaiter(AnyWaiter &waiter)
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mAnyWaiters.push_back(&waiter);
+    }
+
+    //-------------------------------------------------------------------------
+    void Event::removeWaiter(AnyWaiter &waiter)
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mAnyWaiters.remove(&waiter);
+    }
+#endif //ndef ZSLIB_INTERNAL_USE_WIN32_EVENT
+
+    //-------------------------------------------------------------------------
+    bool Event::internalWait(const WaitTime *waitUntil)
+    {
+#ifdef ZSLIB_INTERNAL_USE_WIN32_EVENT
+      if (NULL == mEvent) return false;
+
+      DWORD milliseconds = INFINITE;
+      if (waitUntil) {
+        auto now = zsLib::steadyNow();
+        milliseconds = (*waitUntil > now ? static_cast<DWORD>(std::chrono::duration_cast<Milliseconds>(*waitUntil - now).count()) : 0);
+      }
+      return WAIT_OBJECT_0 == ::WaitForSingleObjectEx(mEvent, milliseconds, FALSE);
+#else
+      std::unique_lock<std::mutex> lock(mMutex);
+
+      auto event = this;
+      auto predicate = [event]() { return event->consume(); };
+
+      if (!waitUntil) {
+        mCondition.wait(lock, predicate);
+        return true;
+      }
+
+      return mCondition.wait_until(lock, *waitUntil, predicate);
+#endif //ZSLIB_INTERNAL_USE_WIN32_EVENT
+    }
+
+    //-------------------------------------------------------------------------
+    bool Event::internalWaitAny(
+                                const std::vector<zsLib::EventPtr> &events,
+                                const WaitTime *waitUntil,
+                                size_t &outIndex
+                                )
+    {
+      ZS_THROW_INVALID_ARGUMENT_IF(events.size() < 1)
+
+#ifdef ZSLIB_INTERNAL_USE_WIN32_EVENT
+      ZS_THROW_INVALID_ARGUMENT_IF(events.size() > MAXIMUM_WAIT_OBJECTS)
+
+      HANDLE handles[MAXIMUM_WAIT_OBJECTS] {};
+      for (size_t index = 0; index < events.size(); ++index) {
+        ZS_THROW_INVALID_ARGUMENT_IF(!events[index])
+        handles[index] = events[index]->mEvent;
+      }
+
+      DWORD milliseconds = INFINITE;
+      if (waitUntil) {
+        auto now = zsLib::steadyNow();
+        milliseconds = (*waitUntil > now ? static_cast<DWORD>(std::chrono::duration_cast<Milliseconds>(*waitUntil - now).count()) : 0);
+      }
+
+      auto result = ::WaitForMultipleObjectsEx(static_cast<DWORD>(events.size()), handles, FALSE, milliseconds, FALSE);
+      if ((result < WAIT_OBJECT_0) ||
+          (result >= WAIT_OBJECT_0 + events.size())) return false;
+
+      outIndex = static_cast<size_t>(result - WAIT_OBJECT_0);
+      return true;
+#else
+      for (auto iter = events.begin(); iter != events.end(); ++iter) {
+        ZS_THROW_INVALID_ARGUMENT_IF(!(*iter))
+      }
+
+      // The waiter is registered with every event before any event is
+      // checked so a notification arriving after an event is checked but
+      // before the waiter sleeps is never lost.
+      AnyWaiter waiter;
+      for (auto iter = events.begin(); iter != events.end(); ++iter) {
+        (*iter)->addWaiter(waiter);
+      }
+
+      bool found = false;
+
+      while (true)
+      {
+        for (size_t index = 0; index < events.size(); ++index) {
+          auto &event = *(events[index]);
+          std::lock_guard<std::mutex> lock(event.mMutex);
+          if (!event.consume()) continue;
+
+          outIndex = index;
+          found = true;
+          break;
+        }
+
+        if (found) break;
+
+        std::unique_lock<std::mutex> lock(waiter.mMutex);
+        auto &signalled = waiter.mSignalled;
+        auto predicate = [&signalled]() { return signalled; };
+
+        if (waitUntil) {
+          if (!waiter.mCondition.wait_until(lock, *waitUntil, predicate)) break;
+        } else {
+          waiter.mCondition.wait(lock, predicate);
+        }
+        signalled = false;
+      }
+
+      for (auto iter = events.begin(); iter != events.end(); ++iter) {
+        (*iter)->removeWaiter(waiter);
+      }
+
+      return found;
+#endif //ZSLIB_INTERNAL_USE_WIN32_EVENT
+    }
+
+    //-------------------------------------------------------------------------
+    Event::WaitTime Event::toWaitTime(Time time)
+    {
+      return zsLib::toSteadyTime(time);
+    }
+
   }
 
   //---------------------------------------------------------------------------
@@ -75,6 +212,7 @@ namespace zsLib
     if (NULL == mEvent) return;
     ::ResetEvent(mEvent);
 #else
+    std::lock_guard<std::mutex> lock(mMutex);
     mNotified = false;
 #endif //_WIN32
   }
@@ -82,20 +220,7 @@ namespace zsLib
   //---------------------------------------------------------------------------
   void Event::wait()
   {
-#ifdef ZSLIB_INTERNAL_USE_WIN32_EVENT
-    if (NULL == mEvent) return;
-    ::WaitForSingleObjectEx(mEvent, INFINITE, FALSE);
-#else
-    std::unique_lock<std::mutex> lock(mMutex);
-
-    if (mManualReset) {
-      auto &notified = mNotified;
-      mCondition.wait(lock, [&notified]() { return (bool)notified; });
-    } else {
-      mCondition.wait(lock);
-  }
-
-#endif //WIN32
+    internalWait(NULL);
   }
 
   //---------------------------------------------------------------------------
@@ -112,7 +237,64 @@ namespace zsLib
     } else {
       mCondition.notify_one();
     }
+
+    for (auto iter = mAnyWaiters.begin(); iter != mAnyWaiters.end(); ++iter) {
+      auto &waiter = *(*iter);
+      std::lock_guard<std::mutex> waiterLock(waiter.mMutex);
+      waiter.mSignalled = true;
+      waiter.mCondition.notify_one();
+    }
 #endif //_WIN32
   }
 
+  //---------------------------------------------------------------------------
+  bool Event::waitFor(Microseconds timeout)
+  {
+    WaitTime waitUntil = zsLib::steadyNow() + timeout;
+    return internalWait(&waitUntil);
+  }
+
+  //---------------------------------------------------------------------------
+  bool Event::waitUntil(Time timeout)
+  {
+    WaitTime waitUntil = toWaitTime(timeout);
+    return internalWait(&waitUntil);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Event::waitAny(const EventList &events)
+  {
+    size_t index {};
+    internalWaitAny(events, NULL, index);
+    return index;
+  }
+
+  //---------------------------------------------------------------------------
+  bool Event::waitAnyFor(
+                         const EventList &events,
+                         Microseconds timeout,
+                         size_t *outIndex
+                         )
+  {
+    size_t index {};
+    WaitTime waitUntil = zsLib::steadyNow() + timeout;
+    bool result = internalWaitAny(events, &waitUntil, index);
+    if ((result) && (outIndex)) *outIndex = index;
+    return result;
+  }
+
+  //---------------------------------------------------------------------------
+  bool Event::waitAnyUntil(
+                           const EventList &events,
+                           Time timeout,
+                           size_t *outIndex
+                           )
+  {
+    size_t index {};
+    WaitTime waitUntil = toWaitTime(timeout);
+    bool result = internalWaitAny(events, &waitUntil, index);
+    if ((result) && (outIndex)) *outIndex = index;
+    return result;
+  }
+
 }
@@ -46,10 +46,39 @@
 #include <fcntl.h>
 #include <signal.h>
 
+#include <thread>
+
 #ifndef _WIN32
 #include <unistd.h>
 #endif //ndef _WIN32
 
+#if defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG)
+#include <sys/socket.h>
+#endif //defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG)
+
+#ifdef HAVE_SENDFILE
+#include <sys/sendfile.h>
+#endif //HAVE_SENDFILE
+
+#ifdef HAVE_MSG_ZEROCOPY
+#include <linux/errqueue.h>
+#include <poll.h>
+#endif //HAVE_MSG_ZEROCOPY
+
+#ifdef _WIN32
+#include <io.h>
+#endif //_WIN32
+
+#define ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS (64)
+#define ZSLIB_SOCKET_MAX_VECTORED_BUFFERS (64)
+#define ZSLIB_SOCKET_SEND_FILE_CHUNK_SIZE_IN_BYTES (16*1024)
+
+#define ZSLIB_SOCKET_BUFFER_POOL_SMALLEST_CLASS_IN_BYTES (256)
+#define ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES (9)                  // 256 bytes to 64KB
+#define ZSLIB_SOCKET_BUFFER_POOL_MAX_RETAINED_PER_CLASS (256)
+#define ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_IN_BYTES (0x10000)
+#define ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_READS_PER_NOTIFICATION (16)
+
 #pragma warning(push)
 #pragma warning(disable:4290)
 
@@ -93,6 +122,18 @@ namespace zsLib
       return zsLib::Log::Params(message, "Socket");
     }
 
+    //-----------------------------------------------------------------------
+    static IPAddress toIPAddress(const sockaddr_in6 &address, socklen_t size)
+    {
+      switch (size)
+      {
+        case sizeof(sockaddr_in):  return IPAddress((const sockaddr_in &)address);
+        case sizeof(sockaddr_in6):
+        default:                   break;
+      }
+      return IPAddress(address);
+    }
+
 #if defined(__QNX__) || defined(__APPLE__)
     //-------------------------------------------------------------------------
     static pthread_once_t &getIgnoreSigTermKeyOnce()
@@ -211,6 +252,178 @@ namespace zsLib
       }
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SocketBufferPool
+    #pragma mark
+
+    ZS_DECLARE_CLASS_PTR(SocketBufferPool)
+
+    class SocketBufferPool
+    {
+    public:
+      //-----------------------------------------------------------------------
+      ~SocketBufferPool()
+      {
+        for (size_t index = 0; index < ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES; ++index) {
+          for (auto iter = mAvailable[index].begin(); iter != mAvailable[index].end(); ++iter) {
+            delete [] (*iter);
+          }
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      static SocketBufferPoolPtr singleton()
+      {
+        static SingletonLazySharedPtr<SocketBufferPool> singleton(make_shared<SocketBufferPool>());
+        return singleton.singleton();
+      }
+
+      //-----------------------------------------------------------------------
+      BYTE *acquire(
+                    size_t sizeInBytes,
+                    size_t &outCapacityInBytes
+                    )
+      {
+        size_t index = toSizeClass(sizeInBytes, outCapacityInBytes);
+        if (index < ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES) {
+          AutoLock lock(mLock);
+          auto &available = mAvailable[index];
+          if (available.size() > 0) {
+            BYTE *buffer = available.back();
+            available.pop_back();
+            return buffer;
+          }
+        }
+        return new BYTE[outCapacityInBytes];
+      }
+
+      //-----------------------------------------------------------------------
+      void release(
+                   BYTE *buffer,
+                   size_t capacityInBytes
+                   )
+      {
+        size_t ignored = 0;
+        size_t index = toSizeClass(capacityInBytes, ignored);
+        if (index < ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES) {
+          AutoLock lock(mLock);
+          auto &available = mAvailable[index];
+          if (available.size() < ZSLIB_SOCKET_BUFFER_POOL_MAX_RETAINED_PER_CLASS) {
+            available.push_back(buffer);
+            return;
+          }
+        }
+        delete [] buffer;
+      }
+
+    protected:
+      //-----------------------------------------------------------------------
+      static size_t toSizeClass(
+                                size_t sizeInBytes,
+                                size_t &outCapacityInBytes
+                                )
+      {
+        size_t capacity = ZSLIB_SOCKET_BUFFER_POOL_SMALLEST_CLASS_IN_BYTES;
+        for (size_t index = 0; index < ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES; ++index, capacity <<= 1) {
+          if (capacity < sizeInBytes) continue;
+          outCapacityInBytes = capacity;
+          return index;
+        }
+
+        outCapacityInBytes = sizeInBytes;                                           // too large to be pooled
+        return ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES;
+      }
+
+    private:
+      Lock mLock;
+      std::vector<BYTE *> mAvailable[ZSLIB_SOCKET_BUFFER_POOL_TOTAL_CLASSES];
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark DirectSocketDelegate
+    #pragma mark
+
+    // forwards notifications on the calling (monitor) thread; a destroyed
+    // delegate is reported exactly like a proxy pointing to a gone delegate
+    // as is a delegate which throws (so a failing delegate never takes down
+    // the monitor thread or the other sockets it monitors)
+    class DirectSocketDelegate : public ISocketDelegate
+    {
+    public:
+      //-----------------------------------------------------------------------
+      DirectSocketDelegate(ISocketDelegatePtr delegate) : mDelegate(delegate) {}
+
+      //-----------------------------------------------------------------------
+      virtual void onReadReady(SocketPtr socket) override {forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onReadReady(socket);});}
+      virtual void onWriteReady(SocketPtr socket) override {forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onWriteReady(socket);});}
+      virtual void onException(SocketPtr socket) override {forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onException(socket);});}
+
+      //-----------------------------------------------------------------------
+      virtual void onZeroCopyCompleted(
+                                       SocketPtr socket,
+                                       ULONG firstSendID,
+                                       ULONG lastSendID,
+                                       bool copied
+                                       ) override
+      {
+        forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onZeroCopyCompleted(socket, firstSendID, lastSendID, copied);});
+      }
+
+      //-----------------------------------------------------------------------
+      virtual void onDataReceived(
+                                  SocketPtr socket,
+                                  SocketBufferPtr buffer
+                                  ) override
+      {
+        forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onDataReceived(socket, buffer);});
+      }
+
+      //-----------------------------------------------------------------------
+      virtual void onIdleTimeout(SocketPtr socket) override {forward(socket, [&](ISocketDelegatePtr &delegate) {delegate->onIdleTimeout(socket);});}
+
+    protected:
+      //-----------------------------------------------------------------------
+      template <typename Notify>
+      void forward(
+                   const SocketPtr &socket,
+                   Notify notify
+                   ) const
+      {
+        ISocketDelegatePtr delegate = mDelegate.lock();
+        if (!delegate) {
+          ZS_THROW_CUSTOM(ISocketDelegateProxy::Exceptions::DelegateGone, "direct socket delegate is gone")
+        }
+
+        try {
+          notify(delegate);
+        } catch (ISocketDelegateProxy::Exceptions::DelegateGone &) {
+          throw;
+        } catch (...) {
+          ZS_LOG_WARNING(Detail, slog("direct socket delegate threw an exception") + ZS_PARAM("socket", socket ? (PTRNUMBER)socket->getSocket() : 0))
+          ZS_THROW_CUSTOM(ISocketDelegateProxy::Exceptions::DelegateGone, "direct socket delegate threw an exception")
+        }
+      }
+
+    private:
+      ISocketDelegateWeakPtr mDelegate;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark Socket
+    #pragma mark
+
     //-------------------------------------------------------------------------
     void Socket::notifyReadReady()
     {
@@ -224,11 +437,88 @@ namespace zsLib
       if (!delegate)
         return;
 
+      ++mStatistics.mReadReadyNotifications;
+
       ZS_EVENTING_1(x, i, Insane, SocketReadReadyEvent, zs, Socket, Event, this, this, this);
 
+      if (mMonitorReceiveIntoPool) {
+        receiveIntoPool(socket, delegate);
+        return;
+      }
+
       delegate->onReadReady(socket);
     }
 
+    //-------------------------------------------------------------------------
+    void Socket::receiveIntoPool(
+                                 SocketPtr socket,
+                                 ISocketDelegatePtr delegate
+                                 )
+    {
+      if (mReceiveIntoPoolEnded) return;                                           // not re-armed thus the stream is no longer monitored for reading
+
+      // every monitor thread receives into its own scratch buffer which is
+      // then copied into a pooled buffer of the smallest fitting size class
+      static thread_local std::unique_ptr<BYTE[]> scratch;
+      if (!scratch) scratch.reset(new BYTE[ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_IN_BYTES]);
+
+      bool datagrams = mReceiveIntoPoolDatagrams;
+
+      for (size_t totalReads = 1; true; ++totalReads) {
+        IPAddress remoteIP;
+        bool wouldBlock = false;
+        int error = 0;
+
+        size_t received = 0;
+        if (datagrams) {
+          received = socket->receiveFrom(remoteIP, scratch.get(), ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_IN_BYTES, &wouldBlock, zsLib::Socket::Receive::None, &error);
+        } else {
+          received = socket->receive(scratch.get(), ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_IN_BYTES, &wouldBlock, zsLib::Socket::Receive::None, &error);
+        }
+        if (wouldBlock) return;
+
+        bool ended = ((!datagrams) && ((0 != error) || (0 == received)));
+        if (ended) mReceiveIntoPoolEnded = true;
+
+        SocketBufferPtr buffer = zsLib::Socket::createBuffer(received);
+        if (received > 0) memcpy(buffer->mBuffer, scratch.get(), received);
+        buffer->mLengthInBytes = received;
+        buffer->mRemoteIP = remoteIP;
+        buffer->mError = error;
+
+        delegate->onDataReceived(socket, buffer);
+
+        if (ended) return;
+
+        if (!mMonitorEdgeTriggered) {
+          // level triggered sockets were re-armed by a successful receive but
+          // a reported datagram error (e.g. WSAECONNRESET from a refused
+          // connected socket) skips the re-arm thus restore read interest
+          if (0 != error) {
+            SocketMonitorPtr monitor;
+            {
+              AutoRecursiveLock lock(mLock);
+              monitor = mMonitor;
+            }
+            if (monitor) monitor->monitorRead(*socket);
+          }
+          return;
+        }
+
+        if (totalReads >= ZSLIB_SOCKET_RECEIVE_INTO_POOL_MAX_READS_PER_NOTIFICATION) {
+          // a busy socket must not starve the other sockets on the monitor
+          // thus it is reported again to continue draining on a later pass
+          SocketMonitorPtr monitor;
+          {
+            AutoRecursiveLock lock(mLock);
+            monitor = mMonitor;
+          }
+          if (monitor) monitor->retriggerRead(*socket);
+          return;
+        }
+      }
+    }
+
     //-------------------------------------------------------------------------
     void Socket::notifyWriteReady()
     {
@@ -242,6 +532,8 @@ namespace zsLib
       if (!delegate)
         return;
 
+      ++mStatistics.mWriteReadyNotifications;
+
       ZS_EVENTING_1(x, i, Insane, SocketWriteReadyEvent, zs, Socket, Event, this, this, this);
 
       delegate->onWriteReady(socket);
@@ -257,20 +549,124 @@ namespace zsLib
         delegate = mDelegate;
         socket = mThis.lock();
       }
+
+      ZeroCopyCompletionList completions;
+      bool completionsOnly = false;
+      {
+        AutoLock lock(mZeroCopyLock);
+        completions.swap(mZeroCopyCompletions);
+        completionsOnly = mZeroCopyCompletionsOnly;
+        mZeroCopyCompletionsOnly = false;
+      }
+
       if (!delegate)
         return;
 
+      for (auto iter = completions.begin(); iter != completions.end(); ++iter) {
+        auto &completion = (*iter);
+        delegate->onZeroCopyCompleted(socket, completion.mFirstSendID, completion.mLastSendID, completion.mCopied);
+      }
+
+      if (completionsOnly)
+        return;
+
+      ++mStatistics.mExceptionNotifications;
+
       ZS_EVENTING_1(x, e, Insane, SocketExceptionEvent, zs, Socket, Exception, this, this, this);
 
       delegate->onException(socket);
     }
 
+    //-------------------------------------------------------------------------
+    void Socket::notifyIdleTimeout()
+    {
+      SocketPtr socket;
+      ISocketDelegatePtr delegate;
+      {
+        AutoRecursiveLock lock(mLock);
+        delegate = mDelegate;
+        socket = mThis.lock();
+      }
+      if (!delegate)
+        return;
+
+      delegate->onIdleTimeout(socket);
+    }
+
+    //-------------------------------------------------------------------------
+    bool Socket::readZeroCopyCompletions(SOCKET handle)
+    {
+      if (!mZeroCopyEnabled)
+        return false;
+
+#ifdef HAVE_MSG_ZEROCOPY
+      ZeroCopyCompletionList completions;
+      bool otherError = false;
+
+      // zero copy completions are queued on the socket's error queue
+      while (true) {
+        char control[128];
+        msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_control = &(control[0]);
+        message.msg_controllen = sizeof(control);
+
+        if (recvmsg(handle, &message, MSG_ERRQUEUE) < 0)
+          break;
+
+        for (cmsghdr *header = CMSG_FIRSTHDR(&message); NULL != header; header = CMSG_NXTHDR(&message, header)) {
+          if (!(((SOL_IP == header->cmsg_level) && (IP_RECVERR == header->cmsg_type)) ||
+                ((SOL_IPV6 == header->cmsg_level) && (IPV6_RECVERR == header->cmsg_type))))
+            continue;
+
+          const sock_extended_err *error = (const sock_extended_err *)CMSG_DATA(header);
+          if (SO_EE_ORIGIN_ZEROCOPY != error->ee_origin) {
+            otherError = true;
+            continue;
+          }
+
+          ZeroCopyCompletion completion;
+          completion.mFirstSendID = static_cast<ULONG>(error->ee_info);
+          completion.mLastSendID = static_cast<ULONG>(error->ee_data);
+          completion.mCopied = (0 != (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED));
+          completions.push_back(completion);
+        }
+      }
+
+      if (!otherError) {
+        // a pending socket error still reports as an error once the queue is drained
+        pollfd check;
+        memset(&check, 0, sizeof(check));
+        check.fd = handle;
+        ::poll(&check, 1, 0);
+        otherError = (0 != (check.revents & (POLLERR | POLLHUP | POLLNVAL)));
+      }
+
+      AutoLock lock(mZeroCopyLock);
+      mZeroCopyCompletions.splice(mZeroCopyCompletions.end(), completions);
+      mZeroCopyCompletionsOnly = !otherError;
+      return !otherError;
+#else
+      return false;
+#endif //HAVE_MSG_ZEROCOPY
+    }
+
     //-------------------------------------------------------------------------
     void Socket::linkSocketMonitor()
     {
       if (mMonitor) return;
 
-      mMonitor = SocketMonitor::link();
+      mMonitor = SocketMonitor::link(reinterpret_cast<PTRNUMBER>(this));
+    }
+
+    //-------------------------------------------------------------------------
+    void Socket::relinkSocketMonitor(SocketMonitorPtr monitor)
+    {
+      if (!monitor) return;
+
+      // only called before a delegate is set thus nothing is registered yet
+      if (mMonitor) mMonitor->unlink();
+      mMonitor = monitor;
     }
 
     //-------------------------------------------------------------------------
@@ -283,6 +679,22 @@ namespace zsLib
       mMonitorReadReady = false;
       mMonitorWriteReady = false;
       mMonitorException = false;
+      mMonitorEdgeTriggered = false;
+      mMonitorReceiveIntoPool = false;
+    }
+
+    //-------------------------------------------------------------------------
+    void Socket::recordSystemCall(bool failed) const
+    {
+      ++mStatistics.mSystemCalls;
+      if (!failed) return;
+
+      int error = WSAGetLastError();
+      switch (error) {
+        case WSAEWOULDBLOCK:
+        case WSAEINPROGRESS:  ++mStatistics.mWouldBlocks; break;
+        default:              ++mStatistics.mErrors; break;
+      }
     }
   }
 
@@ -292,6 +704,40 @@ namespace zsLib
     internal::ignoreSigTermOnThread();
   }
 
+  //---------------------------------------------------------------------------
+  Socket::MonitorLoadList Socket::getMonitorLoads()
+  {
+    return internal::SocketMonitor::getLoads();
+  }
+
+  //---------------------------------------------------------------------------
+  SocketBuffer::~SocketBuffer()
+  {
+    if (NULL == mBuffer) return;
+
+    auto pool = internal::SocketBufferPool::singleton();
+    if (pool) {
+      pool->release(mBuffer, mCapacityInBytes);
+      return;
+    }
+    delete [] mBuffer;
+  }
+
+  //---------------------------------------------------------------------------
+  SocketBufferPtr Socket::createBuffer(size_t inSizeInBytes)
+  {
+    SocketBufferPtr buffer(make_shared<SocketBuffer>());
+
+    auto pool = internal::SocketBufferPool::singleton();
+    if (pool) {
+      buffer->mBuffer = pool->acquire(inSizeInBytes, buffer->mCapacityInBytes);
+    } else {
+      buffer->mCapacityInBytes = inSizeInBytes;
+      buffer->mBuffer = new BYTE[inSizeInBytes];
+    }
+    return buffer;
+  }
+
   //---------------------------------------------------------------------------
   SocketPtr Socket::create() throw(Exceptions::Unspecified)
   {
@@ -379,6 +825,7 @@ namespace zsLib
   SOCKET Socket::orphan()
   {
     setDelegate();    // clear out the delegate
+    cancelSubmitted();
 
     AutoRecursiveLock lock(mLock);
     SOCKET temp = mSocket;
@@ -411,6 +858,26 @@ namespace zsLib
       ZS_THROW_INVALID_USAGE_IF(!ISocketDelegateProxy::isProxy(delegate))
     }
 
+    attachDelegate(delegate);
+  }
+
+  //---------------------------------------------------------------------------
+  void Socket::setDirectDelegate(ISocketDelegatePtr originalDelegate) throw (Socket::Exceptions::InvalidSocket)
+  {
+    ISocketDelegatePtr delegate;
+
+    if (originalDelegate) {
+      // a proxy would defeat the purpose of calling the delegate directly
+      ZS_THROW_INVALID_USAGE_IF(ISocketDelegateProxy::isProxy(originalDelegate))
+      delegate = make_shared<internal::DirectSocketDelegate>(originalDelegate);
+    }
+
+    attachDelegate(delegate);
+  }
+
+  //---------------------------------------------------------------------------
+  void Socket::attachDelegate(ISocketDelegatePtr delegate)
+  {
     bool remove = false;
 
     {
@@ -426,6 +893,7 @@ namespace zsLib
     bool monitorRead = true;
     bool monitorWrite = true;
     bool monitorException = true;
+    bool monitorEdgeTriggered = false;
 
     {
       AutoRecursiveLock lock(mLock);
@@ -436,10 +904,11 @@ namespace zsLib
       monitorRead = mMonitorReadReady;
       monitorWrite = mMonitorWriteReady;
       monitorException = mMonitorException;
+      monitorEdgeTriggered = mMonitorEdgeTriggered;
     }
 
     if (delegate)
-      mMonitor->monitorBegin(mThis.lock(), monitorRead, monitorWrite, monitorException);
+      mMonitor->monitorBegin(mThis.lock(), monitorRead, monitorWrite, monitorException, monitorEdgeTriggered);
   }
 
   //---------------------------------------------------------------------------
@@ -449,6 +918,7 @@ namespace zsLib
     bool monitorRead = true;
     bool monitorWrite = true;
     bool monitorException = true;
+    bool monitorEdgeTriggered = false;
 
     {
       AutoRecursiveLock lock(mLock);
@@ -456,98 +926,305 @@ namespace zsLib
       bool oldMonitorRead = mMonitorReadReady;
       bool oldMonitorWrite = mMonitorWriteReady;
       bool oldMonitorException = mMonitorException;
+      bool oldMonitorEdgeTriggered = mMonitorEdgeTriggered;
+      bool oldMonitorReceiveIntoPool = mMonitorReceiveIntoPool;
 
       mMonitorReadReady = (0 != (options & Monitor::Read));
       mMonitorWriteReady = (0 != (options & Monitor::Write));
       mMonitorException = (0 != (options & Monitor::Exception));
+      mMonitorEdgeTriggered = (0 != (options & Monitor::EdgeTriggered));
+
+      if ((0 != (options & Monitor::ReceiveIntoPool)) &&
+          (!oldMonitorReceiveIntoPool)) {
+        bool datagrams = false;
+        try {
+          datagrams = (SOCK_DGRAM == getOptionValue(GetOptionValue::Type));
+        } catch (...) {
+        }
+        mReceiveIntoPoolDatagrams = datagrams;
+        mReceiveIntoPoolEnded = false;
+      }
+      mMonitorReceiveIntoPool = (0 != (options & Monitor::ReceiveIntoPool));
 
       if ((oldMonitorRead == mMonitorReadReady) &&
           (oldMonitorWrite == mMonitorWriteReady) &&
-          (oldMonitorException == mMonitorException)) {
+          (oldMonitorException == mMonitorException) &&
+          (oldMonitorEdgeTriggered == mMonitorEdgeTriggered)) {
         return;
       }
 
       monitorRead = mMonitorReadReady;
       monitorWrite = mMonitorWriteReady;
       monitorException = mMonitorException;
+      monitorEdgeTriggered = mMonitorEdgeTriggered;
       delegate = mDelegate;
 
       if (!mDelegate) return;
     }
 
     mMonitor->monitorEnd(*this);
-    mMonitor->monitorBegin(mThis.lock(), monitorRead, monitorWrite, monitorException);
+    mMonitor->monitorBegin(mThis.lock(), monitorRead, monitorWrite, monitorException, monitorEdgeTriggered);
   }
 
   //---------------------------------------------------------------------------
-  void Socket::close() throw(Exceptions::WouldBlock, Exceptions::Unspecified)
+  void Socket::setIdleTimeout(Milliseconds timeout)
   {
-    internal::ignoreSigTermOnThread();
-
-    setDelegate();
-
-    AutoRecursiveLock lock(mLock);
-    if (INVALID_SOCKET == mSocket)
-      return;
+    mIdleTimeoutInMilliseconds = timeout.count();
 
-    ZS_LOG_TRACE(internal::slog("closing socket") + ZS_PARAM("socket", (PTRNUMBER)mSocket))
+    {
+      AutoRecursiveLock lock(mLock);
+      if (!mDelegate) return;                                                       // applied once the socket is monitored
+    }
 
-    int result = closesocket(mSocket);
+    mMonitor->setIdleTimeout(*this, timeout);
+  }
 
-    ZS_EVENTING_2(x, i, Debug, SocketClose, zs, Socket, Stop, socket, socket, static_cast<uint64_t>(mSocket), int, result, result);
+  //---------------------------------------------------------------------------
+  Milliseconds Socket::getIdleTimeout() const
+  {
+    return Milliseconds(mIdleTimeoutInMilliseconds);
+  }
 
-    mSocket = INVALID_SOCKET;
-    if (SOCKET_ERROR == result)
+  //---------------------------------------------------------------------------
+  void Socket::setBusyPoll(const BusyPollOptions &options) throw (Exceptions::InvalidSocket)
+  {
     {
-      int error = WSAGetLastError();
-      ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
-      switch (error)
-      {
-        case WSAEWOULDBLOCK: ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "closesocket on an asynchronous socket would block, where socket id=" + (string((PTRNUMBER)mSocket))); break;
-        default:             ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "closesocket returned an unexpected error, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+      ZS_THROW_INVALID_USAGE_IF(mDelegate)                                          // the monitor cannot change while monitored
+    }
+
+    if (Microseconds() != options.mKernelBusyPoll) {
+      try {
+        setOptionValue(SetOptionValue::BusyPollInMicroseconds, static_cast<ULONG>(options.mKernelBusyPoll.count()));
+      } catch (...) {
+        // the spinning monitor still removes the wake-up latency
+        ZS_LOG_WARNING(Detail, internal::slog("kernel busy poll could not be applied") + ZS_PARAM("socket", (PTRNUMBER)mSocket) + ZS_PARAM("busy poll", options.mKernelBusyPoll))
       }
     }
+
+    ZS_LOG_DETAIL(internal::slog("socket busy polled") + ZS_PARAM("socket", (PTRNUMBER)mSocket) + ZS_PARAM("cpu", options.mCPU) + ZS_PARAM("spin timeout", options.mSpinTimeout))
+
+    relinkSocketMonitor(internal::SocketMonitor::linkBusyPoll(options.mCPU, options.mSpinTimeout));
   }
 
   //---------------------------------------------------------------------------
-  IPAddress Socket::getLocalAddress() const throw (Exceptions::InvalidSocket, Exceptions::Unspecified)
+  void Socket::setCompletionDelegate(ISocketCompletionDelegatePtr originalDelegate) throw (Socket::Exceptions::InvalidSocket)
   {
-    internal::ignoreSigTermOnThread();
-
-    AutoRecursiveLock lock(mLock);
-    ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+    ISocketCompletionDelegatePtr delegate = ISocketCompletionDelegateProxy::createWeak(originalDelegate);
 
-    sockaddr_in6 address;
-    memset(&address, 0, sizeof(address));
-    socklen_t size = sizeof(address);
-    int result = getsockname(
-                             mSocket,
-                             (sockaddr *)&address,
-                             &size
-                             );
+    if (delegate) {
+      // only supported if using a proxy mechanism
+      ZS_THROW_INVALID_USAGE_IF(!ISocketCompletionDelegateProxy::isProxy(delegate))
+    }
 
-    ZS_EVENTING_4(x, i, Debug, SocketGetLocalAddress, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), int, result, result, buffer, address, &address, size, size, size);
+    AutoRecursiveLock lock(mLock);
 
-    if (SOCKET_ERROR == result)
-    {
-      int error = WSAGetLastError();
-      ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
-      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "getsockname returned an unexpected error, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
+    if (!delegate) {
+      mCompletionDelegate.reset();
+      return;
     }
 
-    IPAddress localIP;
-    switch (size)
-    {
-      case sizeof(sockaddr_in):  localIP = IPAddress((sockaddr_in &)address); break;
-      case sizeof(sockaddr_in6):
-      default:                   localIP = IPAddress(address); break;
+    ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, INVALID_SOCKET == mSocket)
+
+    mCompletionDelegate = delegate;
+    if (!mCompletionEngine) {
+      mCompletionEngine = internal::SocketCompletionEngine::link();
     }
 
-    return localIP;
+    ZS_LOG_TRACE(internal::slog("completion delegate set") + ZS_PARAM("socket", (PTRNUMBER)mSocket) + ZS_PARAM("engine", mCompletionEngine ? mCompletionEngine->getEngineName() : ""))
   }
 
   //---------------------------------------------------------------------------
-  IPAddress Socket::getRemoteAddress() const throw (Exceptions::InvalidSocket, Exceptions::Unspecified)
+  String Socket::getCompletionEngineName() const
+  {
+    AutoRecursiveLock lock(mLock);
+    if (!mCompletionEngine) return String();
+    return String(mCompletionEngine->getEngineName());
+  }
+
+  //---------------------------------------------------------------------------
+  PUID Socket::submitReceive(
+                             BYTE *ioBuffer,
+                             size_t inBufferLengthInBytes,
+                             ULONG flags
+                             ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet)
+  {
+    return submitOperation(internal::SocketCompletionEngine::OperationType_Receive, ioBuffer, inBufferLengthInBytes, flags);
+  }
+
+  //---------------------------------------------------------------------------
+  PUID Socket::submitSend(
+                          const BYTE *inBuffer,
+                          size_t inBufferLengthInBytes,
+                          ULONG flags
+                          ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet)
+  {
+    return submitOperation(internal::SocketCompletionEngine::OperationType_Send, const_cast<BYTE *>(inBuffer), inBufferLengthInBytes, flags);
+  }
+
+  //---------------------------------------------------------------------------
+  PUID Socket::submitAccept() throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet)
+  {
+    return submitOperation(internal::SocketCompletionEngine::OperationType_Accept, NULL, 0, 0);
+  }
+
+  //---------------------------------------------------------------------------
+  void Socket::cancelSubmitted()
+  {
+    internal::SocketCompletionEnginePtr engine;
+    SOCKET handle = INVALID_SOCKET;
+
+    {
+      AutoRecursiveLock lock(mLock);
+      engine = mCompletionEngine;
+      handle = mSocket;
+    }
+
+    if ((!engine) || (INVALID_SOCKET == handle)) return;
+
+    engine->cancel(handle);
+  }
+
+  //---------------------------------------------------------------------------
+  PUID Socket::submitOperation(
+                               int operationType,
+                               BYTE *buffer,
+                               size_t bufferLengthInBytes,
+                               ULONG flags
+                               ) throw (Exceptions::InvalidSocket, Exceptions::DelegateNotSet)
+  {
+    internal::SocketCompletionEnginePtr engine;
+    internal::SocketCompletionEngine::Operation operation;
+
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, INVALID_SOCKET == mSocket)
+      ZS_THROW_CUSTOM_IF(Exceptions::DelegateNotSet, !mCompletionDelegate)
+
+      engine = mCompletionEngine;
+
+      operation.mType = static_cast<internal::SocketCompletionEngine::OperationTypes>(operationType);
+      operation.mSocket = mThis.lock();
+      operation.mHandle = mSocket;
+      operation.mDelegate = mCompletionDelegate;
+      operation.mBuffer = buffer;
+      operation.mBufferLengthInBytes = bufferLengthInBytes;
+      operation.mFlags = flags;
+    }
+
+    return engine->submit(operation);
+  }
+
+  //---------------------------------------------------------------------------
+  Socket::Statistics Socket::getStatistics() const
+  {
+    Statistics result;
+    result.mBytesReceived = mStatistics.mBytesReceived;
+    result.mBytesSent = mStatistics.mBytesSent;
+    result.mPacketsReceived = mStatistics.mPacketsReceived;
+    result.mPacketsSent = mStatistics.mPacketsSent;
+    result.mSystemCalls = mStatistics.mSystemCalls;
+    result.mWouldBlocks = mStatistics.mWouldBlocks;
+    result.mErrors = mStatistics.mErrors;
+    result.mReadReadyNotifications = mStatistics.mReadReadyNotifications;
+    result.mWriteReadyNotifications = mStatistics.mWriteReadyNotifications;
+    result.mExceptionNotifications = mStatistics.mExceptionNotifications;
+    result.mRearms = mStatistics.mRearms;
+    result.mAccepted = mStatistics.mAccepted;
+    return result;
+  }
+
+  //---------------------------------------------------------------------------
+  void Socket::close() throw(Exceptions::WouldBlock, Exceptions::Unspecified)
+  {
+    internal::ignoreSigTermOnThread();
+
+    setDelegate();
+    cancelSubmitted();
+
+    AutoRecursiveLock lock(mLock);
+    if (INVALID_SOCKET == mSocket)
+      return;
+
+    ZS_LOG_TRACE(internal::slog("closing socket") + ZS_PARAM("socket", (PTRNUMBER)mSocket))
+
+    {
+      Statistics stats = getStatistics();
+      ZS_EVENTING_13(
+                     x, i, Debug, SocketStatistics, zs, Socket, Info,
+                     socket, socket, static_cast<uint64_t>(mSocket),
+                     size_t, bytesReceived, stats.mBytesReceived,
+                     size_t, bytesSent, stats.mBytesSent,
+                     size_t, packetsReceived, stats.mPacketsReceived,
+                     size_t, packetsSent, stats.mPacketsSent,
+                     size_t, systemCalls, stats.mSystemCalls,
+                     size_t, wouldBlocks, stats.mWouldBlocks,
+                     size_t, errors, stats.mErrors,
+                     size_t, readReadyNotifications, stats.mReadReadyNotifications,
+                     size_t, writeReadyNotifications, stats.mWriteReadyNotifications,
+                     size_t, exceptionNotifications, stats.mExceptionNotifications,
+                     size_t, rearms, stats.mRearms,
+                     size_t, accepted, stats.mAccepted
+                     );
+    }
+
+    int result = closesocket(mSocket);
+
+    ZS_EVENTING_2(x, i, Debug, SocketClose, zs, Socket, Stop, socket, socket, static_cast<uint64_t>(mSocket), int, result, result);
+
+    mSocket = INVALID_SOCKET;
+    if (SOCKET_ERROR == result)
+    {
+      int error = WSAGetLastError();
+      ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+      switch (error)
+      {
+        case WSAEWOULDBLOCK: ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "closesocket on an asynchronous socket would block, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+        default:             ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "closesocket returned an unexpected error, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
+      }
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  IPAddress Socket::getLocalAddress() const throw (Exceptions::InvalidSocket, Exceptions::Unspecified)
+  {
+    internal::ignoreSigTermOnThread();
+
+    AutoRecursiveLock lock(mLock);
+    ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+    sockaddr_in6 address;
+    memset(&address, 0, sizeof(address));
+    socklen_t size = sizeof(address);
+    int result = getsockname(
+                             mSocket,
+                             (sockaddr *)&address,
+                             &size
+                             );
+
+    ZS_EVENTING_4(x, i, Debug, SocketGetLocalAddress, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), int, result, result, buffer, address, &address, size, size, size);
+
+    if (SOCKET_ERROR == result)
+    {
+      int error = WSAGetLastError();
+      ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "getsockname returned an unexpected error, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
+    }
+
+    IPAddress localIP;
+    switch (size)
+    {
+      case sizeof(sockaddr_in):  localIP = IPAddress((sockaddr_in &)address); break;
+      case sizeof(sockaddr_in6):
+      default:                   localIP = IPAddress(address); break;
+    }
+
+    return localIP;
+  }
+
+  //---------------------------------------------------------------------------
+  IPAddress Socket::getRemoteAddress() const throw (Exceptions::InvalidSocket, Exceptions::Unspecified)
   {
     internal::ignoreSigTermOnThread();
 
@@ -726,11 +1403,12 @@ namespace zsLib
       socklen_t size = sizeof(address);
       acceptSocket = ::accept(mSocket, (sockaddr *)(&address), &size);
       ZS_EVENTING_4(x, i, Debug, SocketAccept, zs, Socket, Accept, socket, listenSocket, static_cast<uint64_t>(mSocket), socket, acceptSocket, static_cast<uint64_t>(acceptSocket), buffer, address, &address, size, size, size);
+      recordSystemCall(INVALID_SOCKET == acceptSocket);
       if (INVALID_SOCKET == acceptSocket)
       {
         int error = handleError(outWouldBlock);
         ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
-        if (0 == error) return SocketPtr();
+        if (0 == error) goto accept_final;
 
         error = handleError(error, outNoThrowErrorResult);
         ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
@@ -751,18 +1429,173 @@ namespace zsLib
       }
     }
 
-    if (mMonitorReadReady)
+  accept_final:
+
+    if (INVALID_SOCKET == acceptSocket) {
+      if ((mMonitorReadReady) &&
+          (mMonitorEdgeTriggered))
+        mMonitor->monitorRead(*this);                                                 // edge triggered sockets re-arm only once drained
+      return SocketPtr();
+    }
+
+    if ((mMonitorReadReady) &&
+        (!mMonitorEdgeTriggered))
       mMonitor->monitorRead(*this);
     if (mMonitorWriteReady)
       mMonitor->monitorWrite(*this);
     if (mMonitorException)
       mMonitor->monitorException(*this);
 
+    ++mStatistics.mAccepted;
+
     SocketPtr result = create();
     result->adopt(acceptSocket);
     return result;
   }
 
+  //---------------------------------------------------------------------------
+  size_t Socket::acceptBatch(
+                             AcceptedSocketList &outSockets,
+                             const AcceptOptions *inOptions,
+                             size_t inMaxSockets,
+                             bool *outWouldBlock,
+                             int *outNoThrowErrorResult
+                             ) const throw(
+                                           Exceptions::InvalidSocket,
+                                           Exceptions::ConnectionReset,
+                                           Exceptions::Unspecified
+                                           )
+  {
+    internal::ignoreSigTermOnThread();
+
+    AcceptOptions defaultOptions;
+    const AcceptOptions &options = (NULL != inOptions ? *inOptions : defaultOptions);
+
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    size_t totalAccepted = 0;
+    bool wouldBlock = false;
+    int error = 0;
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+#ifndef _WIN32
+      // a blocking listener would wait for further connections while holding
+      // the lock thus only a single connection is accepted per batch
+      int statusFlags = fcntl(mSocket, F_GETFL, 0);
+      bool blocking = ((SOCKET_ERROR != statusFlags) && (0 == (O_NONBLOCK & statusFlags)));
+#endif //ndef _WIN32
+
+      while ((0 == inMaxSockets) ||
+             (totalAccepted < inMaxSockets)) {
+        if (0 != totalAccepted) {
+#ifdef _WIN32
+          // the blocking mode cannot be queried thus only accept while a
+          // connection is known to be pending
+          fd_set readSet;
+          FD_ZERO(&readSet);
+          FD_SET(mSocket, &readSet);
+          timeval noWait {};
+          if (1 != ::select(0, &readSet, NULL, NULL, &noWait)) {
+            wouldBlock = true;
+            break;
+          }
+#else
+          if (blocking) break;
+#endif //_WIN32
+        }
+
+        sockaddr_in6 address;
+        memset(&address, 0, sizeof(address));
+        address.sin6_family = AF_INET6;
+        socklen_t size = sizeof(address);
+#ifdef HAVE_ACCEPT4
+        SOCKET acceptSocket = accept4(mSocket, (sockaddr *)(&address), &size, SOCK_CLOEXEC | (options.mNonBlocking ? SOCK_NONBLOCK : 0));
+#else
+        SOCKET acceptSocket = ::accept(mSocket, (sockaddr *)(&address), &size);
+#endif //HAVE_ACCEPT4
+        ZS_EVENTING_4(x, i, Debug, SocketAccept, zs, Socket, Accept, socket, listenSocket, static_cast<uint64_t>(mSocket), socket, acceptSocket, static_cast<uint64_t>(acceptSocket), buffer, address, &address, size, size, size);
+        recordSystemCall(INVALID_SOCKET == acceptSocket);
+
+        if (INVALID_SOCKET == acceptSocket) {
+          error = handleError(&wouldBlock);
+          if (0 != error) {
+            ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+          }
+          break;
+        }
+
+        ++mStatistics.mAccepted;
+
+        AcceptedSocket accepted;
+        accepted.mRemoteIP = internal::toIPAddress(address, size);
+        accepted.mSocket = create();
+        accepted.mSocket->adopt(acceptSocket);
+
+        // an option which cannot be applied must neither lose the accepted
+        // connection nor leave the listener without its re-arm
+        try {
+#ifndef HAVE_ACCEPT4
+          if (options.mNonBlocking)
+            accepted.mSocket->setOptionFlag(SetOptionFlag::NonBlocking, true);
+#endif //ndef HAVE_ACCEPT4
+          if (options.mTCPNoDelay)
+            accepted.mSocket->setOptionFlag(SetOptionFlag::TCPNoDelay, true);
+          if (options.mKeepAlive)
+            accepted.mSocket->setOptionFlag(SetOptionFlag::KeepAlive, true);
+          if (0 != options.mReceiveBufferSizeInBytes)
+            accepted.mSocket->setOptionValue(SetOptionValue::ReceiverBufferSizeInBytes, options.mReceiveBufferSizeInBytes);
+          if (0 != options.mSendBufferSizeInBytes)
+            accepted.mSocket->setOptionValue(SetOptionValue::SendBufferSizeInBytes, options.mSendBufferSizeInBytes);
+        } catch (Exceptions::InvalidSocket &) {
+          ZS_LOG_WARNING(Detail, internal::slog("accept options could not be applied") + ZS_PARAM("socket", (PTRNUMBER)acceptSocket))
+        } catch (Exceptions::Unspecified &) {
+          ZS_LOG_WARNING(Detail, internal::slog("accept options could not be applied") + ZS_PARAM("socket", (PTRNUMBER)acceptSocket))
+        }
+
+        outSockets.push_back(accepted);
+        ++totalAccepted;
+      }
+    }
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = wouldBlock;
+
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || (wouldBlock)))   // edge triggered sockets re-arm only once drained
+      mMonitor->monitorRead(*this);
+    if ((totalAccepted > 0) &&
+        (mMonitorWriteReady))
+      mMonitor->monitorWrite(*this);
+    if ((totalAccepted > 0) &&
+        (mMonitorException))
+      mMonitor->monitorException(*this);
+
+    if (0 != error) {
+      if (totalAccepted > 0) {
+        // the connections already accepted must reach the caller thus the
+        // error is only reported when asked for (or by the next call)
+        if (outNoThrowErrorResult)
+          *outNoThrowErrorResult = error;
+        return totalAccepted;
+      }
+
+      error = handleError(error, outNoThrowErrorResult);
+      switch (error)
+      {
+        case 0:             break;
+        case WSAECONNRESET: ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "New connection was indicated but connection was reset before it could be accepted, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+        default:            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "Unexpected error accepting new connection, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+      }
+    }
+
+    return totalAccepted;
+  }
+
   //---------------------------------------------------------------------------
   void Socket::connect(
                        const IPAddress &inDestination,
@@ -882,6 +1715,8 @@ namespace zsLib
                       );
 
       ZS_EVENTING_5(x, i, Trace, SocketRecv, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, ioBuffer, size, size, inBufferLengthInBytes);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (result > 0) recordReceived(static_cast<size_t>(result));
 
       if (SOCKET_ERROR == result)
       {
@@ -916,7 +1751,8 @@ namespace zsLib
 
   receive_final:
 
-    if (mMonitorReadReady)
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once drained
       mMonitor->monitorRead(*this);
 
     return static_cast<size_t>(result);
@@ -968,6 +1804,8 @@ namespace zsLib
                         );
 
       ZS_EVENTING_7(x, i, Trace, SocketRecvFrom, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, ioBuffer, size, size, inBufferLengthInBytes, binary, address, &address, size, addressSize, size);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (SOCKET_ERROR != result) recordReceived(static_cast<size_t>(result));
 
       if (SOCKET_ERROR == result)
       {
@@ -1007,7 +1845,8 @@ namespace zsLib
     }
   recvfrom_final:
 
-    if (mMonitorReadReady)
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once drained
       mMonitor->monitorRead(*this);
 
     return static_cast<size_t>(result);
@@ -1054,6 +1893,8 @@ namespace zsLib
                       );
 
       ZS_EVENTING_5(x, i, Trace, SocketSend, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, inBuffer, size, size, inBufferLengthInBytes);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (result > 0) recordSent(static_cast<size_t>(result));
 
       if (SOCKET_ERROR == result)
       {
@@ -1088,7 +1929,8 @@ namespace zsLib
     }
   send_final:
 
-    if (mMonitorWriteReady)
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once full
       mMonitor->monitorWrite(*this);
 
     return static_cast<size_t>(result);
@@ -1145,6 +1987,8 @@ namespace zsLib
                         );
 
       ZS_EVENTING_7(x, i, Trace, SocketSendTo, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, inBuffer, size, size, inBufferLengthInBytes, binary, address, address, size, addressSize, size);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (SOCKET_ERROR != result) recordSent(static_cast<size_t>(result));
 
       if (SOCKET_ERROR == result)
       {
@@ -1180,85 +2024,986 @@ namespace zsLib
 
   sendto_final:
 
-    if (mMonitorWriteReady)
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once full
       mMonitor->monitorWrite(*this);
 
     return static_cast<size_t>(result);
   }
 
   //---------------------------------------------------------------------------
-  void Socket::shutdown(Shutdown::Options inOptions) const throw(Exceptions::InvalidSocket, Exceptions::Unspecified)
+  size_t Socket::sendFile(
+                          int inFileDescriptor,
+                          uint64_t inOffset,
+                          size_t inLengthInBytes,
+                          bool *outWouldBlock,
+                          int *outNoThrowErrorResult
+                          ) const throw(
+                                        Exceptions::InvalidSocket,
+                                        Exceptions::WouldBlock,
+                                        Exceptions::Shutdown,
+                                        Exceptions::HostNotReachable,
+                                        Exceptions::ConnectionAborted,
+                                        Exceptions::ConnectionReset,
+                                        Exceptions::Timeout,
+                                        Exceptions::BufferTooSmall,
+                                        Exceptions::Unspecified
+                                        )
   {
     internal::ignoreSigTermOnThread();
 
+    ssize_t result = 0;
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = false;
+
+    // scope:
     {
       AutoRecursiveLock lock(mLock);
       ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
 
-      int result = ::shutdown(mSocket, inOptions);
-      ZS_EVENTING_3(x, i, Debug, SocketShutdown, zs, Socket, Shutdown, socket, socket, static_cast<uint64_t>(mSocket), int, result, result, enum, options, to_underlying(inOptions));
+      if (0 == inLengthInBytes)
+        return 0;
 
-      if (SOCKET_ERROR == result)
-      {
-        int error = WSAGetLastError();
-        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
-        ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "Failed to perform a shutdown on the socket, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
-      }
-    }
+      ZS_THROW_INVALID_ARGUMENT_IF(inFileDescriptor < 0)
 
-    if (mMonitorReadReady)
-      mMonitor->monitorRead(*this);
-    if (mMonitorWriteReady)
-      mMonitor->monitorWrite(*this);
-    if (mMonitorException)
-      mMonitor->monitorException(*this);
-  }
+#ifdef HAVE_SENDFILE
+      off_t offset = static_cast<off_t>(inOffset);
+      result = ::sendfile(mSocket, inFileDescriptor, &offset, inLengthInBytes);
+#else
+      // no kernel assisted path, read a chunk of the file and send it
+      BYTE buffer[ZSLIB_SOCKET_SEND_FILE_CHUNK_SIZE_IN_BYTES];
+      size_t chunkSize = (inLengthInBytes > sizeof(buffer) ? sizeof(buffer) : inLengthInBytes);
 
-  namespace internal
-  {
-    //-------------------------------------------------------------------------
-    static void setSocketOptions(
-                                 SOCKET inSocket,
-                                 int inLevel,
-                                 int inOptionName,
-                                 BYTE *inOptionValue,
-                                 socklen_t inOptionLength
-                                 )
-    {
-      int result = ::setsockopt(inSocket, inLevel, inOptionName, (const char *)inOptionValue, inOptionLength);
-      ZS_EVENTING_6(x, i, Debug, SocketSetOption, zs, Socket, Option, socket, socket, static_cast<uint64_t>(inSocket), int, result, result, int, level, inLevel, int, optionName, inOptionName, binary, optionValue, inOptionValue, size, optionValueSize, inOptionLength);
+#ifdef _WIN32
+      ssize_t totalRead = -1;
+      if (_lseeki64(inFileDescriptor, static_cast<__int64>(inOffset), SEEK_SET) >= 0)
+        totalRead = _read(inFileDescriptor, &(buffer[0]), static_cast<unsigned int>(chunkSize));
+#else
+      ssize_t totalRead = ::pread(inFileDescriptor, &(buffer[0]), chunkSize, static_cast<off_t>(inOffset));
+#endif //_WIN32
 
-      if (SOCKET_ERROR == result)
-      {
-        int error = WSAGetLastError();
-        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(inSocket), int, error, error);
-        ZS_THROW_CUSTOM_PROPERTIES_1(zsLib::Socket::Exceptions::Unspecified, error, "setsockopt failed, where socket id=" + (string((PTRNUMBER)inSocket)) + ", socket option=" + (string(inOptionName)) + ", error=" + (string(error)))
+      if (totalRead < 0) {
+        int error = errno;
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+        if (NULL != outNoThrowErrorResult) {
+          *outNoThrowErrorResult = error;
+          return 0;
+        }
+        ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "Cannot read file data to send, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)));
       }
-    }
 
-    //-------------------------------------------------------------------------
-    static void getSocketOptions(
-                                 SOCKET inSocket,
-                                 int inLevel,
-                                 int inOptionName,
-                                 BYTE *outOptionValue,
-                                 socklen_t inOptionLength
-                                 )
-    {
-      socklen_t length = inOptionLength;
-      int result = ::getsockopt(inSocket, inLevel, inOptionName, (char *)outOptionValue, &length);
-      ZS_EVENTING_6(x, i, Debug, SocketGetOptions, zs, Socket, Option, socket, socket, static_cast<uint64_t>(inSocket), int, result, result, int, level, inLevel, int, optionName, inOptionName, binary, optionValue, outOptionValue, size, optionValueSize, inOptionLength);
+      result = 0;
+      if (totalRead > 0) {
+        result = ::send(
+                        mSocket,
+                        (const char *)&(buffer[0]),
+                        SafeInt<int>(totalRead),
+                        0
+                        );
+      }
+#endif //HAVE_SENDFILE
+
+      ZS_EVENTING_5(x, i, Trace, SocketSend, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, 0, buffer, buffer, static_cast<const BYTE *>(NULL), size, size, inLengthInBytes);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (result > 0) recordSent(static_cast<size_t>(result));
 
       if (SOCKET_ERROR == result)
       {
-        int error = WSAGetLastError();
-        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(inSocket), int, error, error);
-        ZS_THROW_CUSTOM_PROPERTIES_1(zsLib::Socket::Exceptions::Unspecified, error, "getsockopt failed, where socket id=" + (string((PTRNUMBER)inSocket)) + ", socket option=" + (string(inOptionName)) + ", error=" + (string(error)))
-      }
-      ZS_THROW_BAD_STATE_IF(length != inOptionLength)
-    }
+        result = 0;
 
-  } // namespace internal
+        int error = handleError(outWouldBlock);
+        ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
+        if (0 == error) goto send_file_final;
+
+        error = handleError(error, outNoThrowErrorResult);
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
+        if (0 == error) return 0;
+
+        switch (error)
+        {
+          case WSAEINPROGRESS:
+          case WSAEWOULDBLOCK:
+          {
+            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "Cannot send socket data as socket would block, where socket id=" + (string((PTRNUMBER)mSocket)));
+            break;
+          }
+          case WSAENETRESET:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as connection keep alive timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAESHUTDOWN:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Shutdown, error, "Cannot send socket data as connection was shutdown, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEHOSTUNREACH:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::HostNotReachable, error, "Cannot send socket data as host is unreachable at this time, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNABORTED:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionAborted, error, "Cannot send socket data as socket connection was aborted, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNRESET:     ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "Cannot send socket data as socket was abruptly closed, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAETIMEDOUT:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as socket timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEMSGSIZE:       ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::BufferTooSmall, error, "Cannot send socket data as buffer provided was too big, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          default:                ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "The send unexpectedly closed, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+        }
+      }
+    }
+
+  send_file_final:
+
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once full
+      mMonitor->monitorWrite(*this);
+
+    return static_cast<size_t>(result);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::receiveVectored(
+                                 const BufferSpan *ioBuffers,
+                                 size_t inTotalBuffers,
+                                 bool *outWouldBlock,
+                                 ULONG inFlags,
+                                 int *outNoThrowErrorResult
+                                 ) const throw(
+                                               Exceptions::InvalidSocket,
+                                               Exceptions::WouldBlock,
+                                               Exceptions::Shutdown,
+                                               Exceptions::ConnectionReset,
+                                               Exceptions::ConnectionAborted,
+                                               Exceptions::Timeout,
+                                               Exceptions::BufferTooSmall,
+                                               Exceptions::Unspecified
+                                               )
+  {
+    internal::ignoreSigTermOnThread();
+
+    ssize_t result = 0;
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = false;
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      if (0 == inTotalBuffers)
+        return 0;
+
+      ZS_THROW_INVALID_ARGUMENT_IF(NULL == ioBuffers)
+      ZS_THROW_INVALID_ARGUMENT_IF(inTotalBuffers > ZSLIB_SOCKET_MAX_VECTORED_BUFFERS)
+
+      size_t totalLengthInBytes = 0;
+
+#ifdef _WIN32
+      WSABUF buffers[ZSLIB_SOCKET_MAX_VECTORED_BUFFERS];
+      for (size_t index = 0; index < inTotalBuffers; ++index) {
+        buffers[index].buf = (char *)ioBuffers[index].mBuffer;
+        buffers[index].len = SafeInt<ULONG>(ioBuffers[index].mLengthInBytes);
+        totalLengthInBytes += ioBuffers[index].mLengthInBytes;
+      }
+
+      DWORD received = 0;
+      DWORD flags = static_cast<DWORD>(inFlags);
+      result = WSARecv(mSocket, &(buffers[0]), static_cast<DWORD>(inTotalBuffers), &received, &flags, NULL, NULL);
+      if (SOCKET_ERROR != result)
+        result = static_cast<ssize_t>(received);
+#else
+      iovec buffers[ZSLIB_SOCKET_MAX_VECTORED_BUFFERS];
+      for (size_t index = 0; index < inTotalBuffers; ++index) {
+        buffers[index].iov_base = ioBuffers[index].mBuffer;
+        buffers[index].iov_len = ioBuffers[index].mLengthInBytes;
+        totalLengthInBytes += ioBuffers[index].mLengthInBytes;
+      }
+
+      msghdr message;
+      memset(&message, 0, sizeof(message));
+      message.msg_iov = &(buffers[0]);
+      message.msg_iovlen = inTotalBuffers;
+
+      result = recvmsg(mSocket, &message, static_cast<int>(inFlags));
+#endif //_WIN32
+
+      ZS_EVENTING_5(x, i, Trace, SocketRecv, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, ioBuffers[0].mBuffer, size, size, totalLengthInBytes);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (result > 0) recordReceived(static_cast<size_t>(result));
+
+      if (SOCKET_ERROR == result)
+      {
+        result = 0;
+
+        int error = handleError(outWouldBlock);
+        ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
+        if (0 == error) goto receive_vectored_final;
+
+        error = handleError(error, outNoThrowErrorResult);
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
+        if (0 == error) return 0;
+
+        switch (error)
+        {
+          case WSAEINPROGRESS:
+          case WSAEWOULDBLOCK:
+          {
+            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "Cannot receive socket data as socket would block, where socket id=" + (string((PTRNUMBER)mSocket)));
+            break;
+          }
+          case WSAESHUTDOWN:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Shutdown, error, "Cannot receive socket data as connection was shutdown, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNRESET:     ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "Cannot receive socket data as socket was abruptly closed, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNABORTED:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionAborted, error, "Cannot receive socket data as socket connection was aborted, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAENETRESET:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot receive socket data as connection keep alive timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAETIMEDOUT:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot receive socket data as socket timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEMSGSIZE:       ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::BufferTooSmall, error, "Cannot receive socket data as buffer provided was too small, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          default:                ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "The receive unexpectedly closed, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+        }
+      }
+    }
+
+  receive_vectored_final:
+
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once drained
+      mMonitor->monitorRead(*this);
+
+    return static_cast<size_t>(result);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::sendVectored(
+                              const BufferSpan *inBuffers,
+                              size_t inTotalBuffers,
+                              bool *outWouldBlock,
+                              ULONG inFlags,
+                              int *outNoThrowErrorResult
+                              ) const throw(
+                                            Exceptions::InvalidSocket,
+                                            Exceptions::WouldBlock,
+                                            Exceptions::Shutdown,
+                                            Exceptions::HostNotReachable,
+                                            Exceptions::ConnectionAborted,
+                                            Exceptions::ConnectionReset,
+                                            Exceptions::Timeout,
+                                            Exceptions::BufferTooSmall,
+                                            Exceptions::Unspecified
+                                            )
+  {
+    internal::ignoreSigTermOnThread();
+
+    ssize_t result = 0;
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = false;
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      if (0 == inTotalBuffers)
+        return 0;
+
+      ZS_THROW_INVALID_ARGUMENT_IF(NULL == inBuffers)
+      ZS_THROW_INVALID_ARGUMENT_IF(inTotalBuffers > ZSLIB_SOCKET_MAX_VECTORED_BUFFERS)
+
+      size_t totalLengthInBytes = 0;
+
+#ifdef _WIN32
+      WSABUF buffers[ZSLIB_SOCKET_MAX_VECTORED_BUFFERS];
+      for (size_t index = 0; index < inTotalBuffers; ++index) {
+        buffers[index].buf = (char *)inBuffers[index].mBuffer;
+        buffers[index].len = SafeInt<ULONG>(inBuffers[index].mLengthInBytes);
+        totalLengthInBytes += inBuffers[index].mLengthInBytes;
+      }
+
+      DWORD sent = 0;
+      result = WSASend(mSocket, &(buffers[0]), static_cast<DWORD>(inTotalBuffers), &sent, static_cast<DWORD>(inFlags), NULL, NULL);
+      if (SOCKET_ERROR != result)
+        result = static_cast<ssize_t>(sent);
+#else
+      iovec buffers[ZSLIB_SOCKET_MAX_VECTORED_BUFFERS];
+      for (size_t index = 0; index < inTotalBuffers; ++index) {
+        buffers[index].iov_base = inBuffers[index].mBuffer;
+        buffers[index].iov_len = inBuffers[index].mLengthInBytes;
+        totalLengthInBytes += inBuffers[index].mLengthInBytes;
+      }
+
+      msghdr message;
+      memset(&message, 0, sizeof(message));
+      message.msg_iov = &(buffers[0]);
+      message.msg_iovlen = inTotalBuffers;
+
+      result = sendmsg(mSocket, &message, static_cast<int>(inFlags));
+#endif //_WIN32
+
+      ZS_EVENTING_5(x, i, Trace, SocketSend, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, inBuffers[0].mBuffer, size, size, totalLengthInBytes);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (result > 0) recordSent(static_cast<size_t>(result));
+
+      if (SOCKET_ERROR == result)
+      {
+        result = 0;
+
+        int error = handleError(outWouldBlock);
+        ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
+        if (0 == error) goto send_vectored_final;
+
+        error = handleError(error, outNoThrowErrorResult);
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
+        if (0 == error) return 0;
+
+        switch (error)
+        {
+          case WSAEINPROGRESS:
+          case WSAEWOULDBLOCK:
+          {
+            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "Cannot send socket data as socket would block, where socket id=" + (string((PTRNUMBER)mSocket)));
+            break;
+          }
+          case WSAENETRESET:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as connection keep alive timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAESHUTDOWN:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Shutdown, error, "Cannot send socket data as connection was shutdown, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEHOSTUNREACH:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::HostNotReachable, error, "Cannot send socket data as host is unreachable at this time, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNABORTED:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionAborted, error, "Cannot send socket data as socket connection was aborted, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNRESET:     ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "Cannot send socket data as socket was abruptly closed, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAETIMEDOUT:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as socket timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEMSGSIZE:       ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::BufferTooSmall, error, "Cannot send socket data as buffer provided was too big, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          default:                ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "The send unexpectedly closed, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+        }
+      }
+    }
+
+  send_vectored_final:
+
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once full
+      mMonitor->monitorWrite(*this);
+
+    return static_cast<size_t>(result);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::receiveFromBatch(
+                                  DatagramBuffer *ioDatagrams,
+                                  size_t inTotalDatagrams,
+                                  bool *outWouldBlock,
+                                  ULONG inFlags
+                                  ) const throw(Exceptions::InvalidSocket)
+  {
+    internal::ignoreSigTermOnThread();
+
+    size_t totalReceived = 0;
+    bool wouldBlock = false;
+
+    for (size_t index = 0; index < inTotalDatagrams; ++index) {
+      ioDatagrams[index].mLengthInBytes = 0;
+      ioDatagrams[index].mError = 0;
+    }
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      while (totalReceived < inTotalDatagrams) {
+        // once a datagram is received the batch must never wait for more
+        // (i.e. a blocking socket only blocks until the first arrives)
+        int flags = static_cast<int>(inFlags);
+#ifdef MSG_DONTWAIT
+        if (0 != totalReceived) flags |= MSG_DONTWAIT;
+#endif //MSG_DONTWAIT
+
+#ifdef HAVE_RECVMMSG
+        size_t totalBatch = inTotalDatagrams - totalReceived;
+        if (totalBatch > ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS) totalBatch = ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS;
+
+        mmsghdr messages[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+        iovec buffers[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+        sockaddr_in6 addresses[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+
+        memset(&(messages[0]), 0, sizeof(messages[0]) * totalBatch);
+        memset(&(addresses[0]), 0, sizeof(addresses[0]) * totalBatch);
+
+        for (size_t index = 0; index < totalBatch; ++index) {
+          DatagramBuffer &datagram = ioDatagrams[totalReceived + index];
+          buffers[index].iov_base = datagram.mBuffer;
+          buffers[index].iov_len = datagram.mBufferLengthInBytes;
+          addresses[index].sin6_family = AF_INET6;
+          messages[index].msg_hdr.msg_name = &(addresses[index]);
+          messages[index].msg_hdr.msg_namelen = sizeof(addresses[index]);
+          messages[index].msg_hdr.msg_iov = &(buffers[index]);
+          messages[index].msg_hdr.msg_iovlen = 1;
+        }
+
+        int result = recvmmsg(mSocket, &(messages[0]), static_cast<unsigned int>(totalBatch), flags | MSG_WAITFORONE, NULL);
+        recordSystemCall(SOCKET_ERROR == result);
+
+        if (SOCKET_ERROR == result) {
+          int error = handleError(&wouldBlock);
+          ioDatagrams[totalReceived].mError = error;
+          if (0 != error) {
+            ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+          }
+          break;
+        }
+
+        for (int index = 0; index < result; ++index) {
+          DatagramBuffer &datagram = ioDatagrams[totalReceived + index];
+          datagram.mLengthInBytes = static_cast<size_t>(messages[index].msg_len);
+          datagram.mAddress = internal::toIPAddress(addresses[index], messages[index].msg_hdr.msg_namelen);
+          if (0 != (messages[index].msg_hdr.msg_flags & MSG_TRUNC)) datagram.mError = WSAEMSGSIZE;
+
+          ZS_EVENTING_7(x, i, Trace, SocketRecvFrom, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, static_cast<ssize_t>(datagram.mLengthInBytes), ulong, flags, inFlags, buffer, buffer, datagram.mBuffer, size, size, datagram.mBufferLengthInBytes, binary, address, &(addresses[index]), size, addressSize, messages[index].msg_hdr.msg_namelen);
+          recordReceived(datagram.mLengthInBytes);
+        }
+
+        totalReceived += static_cast<size_t>(result);
+
+        // a short batch is returned as soon as no more datagrams are pending
+        // (which is not reported as "would block" as the kernel never said so)
+        if (static_cast<size_t>(result) < totalBatch) break;
+#else
+        DatagramBuffer &datagram = ioDatagrams[totalReceived];
+
+        sockaddr_in6 address;
+        memset(&address, 0, sizeof(address));
+        address.sin6_family = AF_INET6;
+        socklen_t size = sizeof(address);
+        ssize_t result = recvfrom(
+                                  mSocket,
+                                  (char *)datagram.mBuffer,
+                                  SafeInt<int>(datagram.mBufferLengthInBytes),
+                                  flags,
+                                  (sockaddr *)&address,
+                                  &size
+                                  );
+
+        ZS_EVENTING_7(x, i, Trace, SocketRecvFrom, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, static_cast<ULONG>(flags), buffer, buffer, datagram.mBuffer, size, size, datagram.mBufferLengthInBytes, binary, address, &address, size, addressSize, size);
+        recordSystemCall(SOCKET_ERROR == result);
+        if (SOCKET_ERROR != result) recordReceived(static_cast<size_t>(result));
+
+        if (SOCKET_ERROR == result) {
+          int error = handleError(&wouldBlock);
+          datagram.mError = error;
+          if (0 != error) {
+            ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+          }
+          break;
+        }
+
+        datagram.mLengthInBytes = static_cast<size_t>(result);
+        datagram.mAddress = internal::toIPAddress(address, size);
+        ++totalReceived;
+
+#ifndef MSG_DONTWAIT
+        break;                                                                  // the next call might block thus stop after the first datagram
+#endif //ndef MSG_DONTWAIT
+#endif //HAVE_RECVMMSG
+      }
+    }
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = wouldBlock;
+
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || (wouldBlock)))   // edge triggered sockets re-arm only once drained
+      mMonitor->monitorRead(*this);
+
+    return totalReceived;
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::sendToBatch(
+                             DatagramBuffer *ioDatagrams,
+                             size_t inTotalDatagrams,
+                             bool *outWouldBlock,
+                             ULONG inFlags
+                             ) const throw(Exceptions::InvalidSocket)
+  {
+    internal::ignoreSigTermOnThread();
+
+    size_t totalSent = 0;
+    bool wouldBlock = false;
+
+    for (size_t index = 0; index < inTotalDatagrams; ++index) {
+      ioDatagrams[index].mLengthInBytes = 0;
+      ioDatagrams[index].mError = 0;
+    }
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      while (totalSent < inTotalDatagrams) {
+#ifdef HAVE_SENDMMSG
+        size_t totalBatch = inTotalDatagrams - totalSent;
+        if (totalBatch > ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS) totalBatch = ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS;
+
+        mmsghdr messages[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+        iovec buffers[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+        sockaddr_in addressesv4[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+        sockaddr_in6 addressesv6[ZSLIB_SOCKET_MAX_BATCH_DATAGRAMS];
+
+        memset(&(messages[0]), 0, sizeof(messages[0]) * totalBatch);
+
+        for (size_t index = 0; index < totalBatch; ++index) {
+          DatagramBuffer &datagram = ioDatagrams[totalSent + index];
+
+          sockaddr *address = NULL;
+          socklen_t size = 0;
+          internal::prepareRawIPAddress(datagram.mAddress, addressesv4[index], addressesv6[index], address, size);
+
+          buffers[index].iov_base = datagram.mBuffer;
+          buffers[index].iov_len = datagram.mBufferLengthInBytes;
+          messages[index].msg_hdr.msg_name = address;
+          messages[index].msg_hdr.msg_namelen = size;
+          messages[index].msg_hdr.msg_iov = &(buffers[index]);
+          messages[index].msg_hdr.msg_iovlen = 1;
+        }
+
+        int result = sendmmsg(mSocket, &(messages[0]), static_cast<unsigned int>(totalBatch), static_cast<int>(inFlags));
+        recordSystemCall(SOCKET_ERROR == result);
+
+        if (SOCKET_ERROR == result) {
+          int error = handleError(&wouldBlock);
+          ioDatagrams[totalSent].mError = error;
+          if (0 != error) {
+            ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+          }
+          break;
+        }
+
+        for (int index = 0; index < result; ++index) {
+          DatagramBuffer &datagram = ioDatagrams[totalSent + index];
+          datagram.mLengthInBytes = static_cast<size_t>(messages[index].msg_len);
+
+          ZS_EVENTING_7(x, i, Trace, SocketSendTo, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, static_cast<ssize_t>(datagram.mLengthInBytes), ulong, flags, inFlags, buffer, buffer, datagram.mBuffer, size, size, datagram.mBufferLengthInBytes, binary, address, messages[index].msg_hdr.msg_name, size, addressSize, messages[index].msg_hdr.msg_namelen);
+          recordSent(datagram.mLengthInBytes);
+        }
+
+        totalSent += static_cast<size_t>(result);
+
+        // a short batch is followed by another attempt so the failing datagram reports its error (or would block)
+#else
+        DatagramBuffer &datagram = ioDatagrams[totalSent];
+
+        sockaddr_in addressv4;
+        sockaddr_in6 addressv6;
+        sockaddr *address = NULL;
+        socklen_t size = 0;
+        internal::prepareRawIPAddress(datagram.mAddress, addressv4, addressv6, address, size);
+
+        ssize_t result = ::sendto(
+                                  mSocket,
+                                  (const char *)datagram.mBuffer,
+                                  SafeInt<int>(datagram.mBufferLengthInBytes),
+                                  static_cast<int>(inFlags),
+                                  address,
+                                  SafeInt<int>(size)
+                                  );
+
+        ZS_EVENTING_7(x, i, Trace, SocketSendTo, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, datagram.mBuffer, size, size, datagram.mBufferLengthInBytes, binary, address, address, size, addressSize, size);
+        recordSystemCall(SOCKET_ERROR == result);
+        if (SOCKET_ERROR != result) recordSent(static_cast<size_t>(result));
+
+        if (SOCKET_ERROR == result) {
+          int error = handleError(&wouldBlock);
+          datagram.mError = error;
+          if (0 != error) {
+            ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+          }
+          break;
+        }
+
+        datagram.mLengthInBytes = static_cast<size_t>(result);
+        ++totalSent;
+#endif //HAVE_SENDMMSG
+      }
+    }
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = wouldBlock;
+
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || (wouldBlock)))   // edge triggered sockets re-arm only once full
+      mMonitor->monitorWrite(*this);
+
+    return totalSent;
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::sendToSegmented(
+                                 const IPAddress &inDestination,
+                                 const BYTE *inBuffer,
+                                 size_t inBufferLengthInBytes,
+                                 size_t inSegmentSizeInBytes,
+                                 bool *outWouldBlock,
+                                 ULONG inFlags,
+                                 int *outNoThrowErrorResult
+                                 ) const throw(
+                                               Exceptions::InvalidSocket,
+                                               Exceptions::WouldBlock,
+                                               Exceptions::Shutdown,
+                                               Exceptions::HostNotReachable,
+                                               Exceptions::ConnectionAborted,
+                                               Exceptions::ConnectionReset,
+                                               Exceptions::Timeout,
+                                               Exceptions::BufferTooSmall,
+                                               Exceptions::Unspecified
+                                               )
+  {
+    internal::ignoreSigTermOnThread();
+
+    ssize_t result = 0;
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = false;
+
+    size_t segmentSize = ((0 == inSegmentSizeInBytes) || (inSegmentSizeInBytes > inBufferLengthInBytes) ? inBufferLengthInBytes : inSegmentSizeInBytes);
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      sockaddr_in addressv4;
+      sockaddr_in6 addressv6;
+      sockaddr *address = NULL;
+      socklen_t size = 0;
+      internal::prepareRawIPAddress(inDestination, addressv4, addressv6, address, size);
+
+#ifdef HAVE_UDP_GSO
+      if (segmentSize < inBufferLengthInBytes) {
+        iovec buffer;
+        buffer.iov_base = const_cast<BYTE *>(inBuffer);
+        buffer.iov_len = inBufferLengthInBytes;
+
+        char control[CMSG_SPACE(sizeof(uint16_t))];
+        memset(&(control[0]), 0, sizeof(control));
+
+        msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_name = address;
+        message.msg_namelen = size;
+        message.msg_iov = &buffer;
+        message.msg_iovlen = 1;
+        message.msg_control = &(control[0]);
+        message.msg_controllen = sizeof(control);
+
+        cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = IPPROTO_UDP;
+        header->cmsg_type = UDP_SEGMENT;
+        header->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t value = SafeInt<uint16_t>(segmentSize);
+        memcpy(CMSG_DATA(header), &value, sizeof(value));
+
+        result = sendmsg(mSocket, &message, static_cast<int>(inFlags));
+
+        ZS_EVENTING_7(x, i, Trace, SocketSendTo, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, inBuffer, size, size, inBufferLengthInBytes, binary, address, address, size, addressSize, size);
+        recordSystemCall(SOCKET_ERROR == result);
+        if (SOCKET_ERROR != result) recordSent(static_cast<size_t>(result), getTotalSegments(static_cast<size_t>(result), segmentSize));
+      } else
+#endif //HAVE_UDP_GSO
+      {
+        // one datagram per segment; a failure after the first segment returns what was sent
+        for (size_t offset = 0; offset < inBufferLengthInBytes; offset += segmentSize) {
+          size_t length = (inBufferLengthInBytes - offset < segmentSize ? inBufferLengthInBytes - offset : segmentSize);
+
+          ssize_t sent = ::sendto(
+                                  mSocket,
+                                  (const char *)(inBuffer + offset),
+                                  SafeInt<int>(length),
+                                  static_cast<int>(inFlags),
+                                  address,
+                                  SafeInt<int>(size)
+                                  );
+
+          ZS_EVENTING_7(x, i, Trace, SocketSendTo, zs, Socket, Send, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, sent, ulong, flags, inFlags, buffer, buffer, inBuffer + offset, size, size, length, binary, address, address, size, addressSize, size);
+          recordSystemCall(SOCKET_ERROR == sent);
+          if (SOCKET_ERROR != sent) recordSent(static_cast<size_t>(sent));
+
+          if (SOCKET_ERROR == sent) {
+            if (0 == offset) result = SOCKET_ERROR;
+            break;
+          }
+          result += sent;
+        }
+      }
+
+      if (SOCKET_ERROR == result)
+      {
+        result = 0;
+
+        int error = handleError(outWouldBlock);
+        ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
+        if (0 == error) goto send_segmented_final;
+
+        error = handleError(error, outNoThrowErrorResult);
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
+        if (0 == error) return 0;
+
+        switch (error)
+        {
+          case WSAEINPROGRESS:
+          case WSAEWOULDBLOCK:
+          {
+            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "Cannot send socket data as socket would block, where socket id=" + (string((PTRNUMBER)mSocket)));
+            break;
+          }
+          case WSAENETRESET:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as connection keep alive timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAESHUTDOWN:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Shutdown, error, "Cannot send socket data as connection was shutdown, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEHOSTUNREACH:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::HostNotReachable, error, "Cannot send socket data as host is unreachable at this time, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNABORTED:   ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionAborted, error, "Cannot send socket data as socket connection was aborted, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNRESET:     ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "Cannot send socket data as socket was abruptly closed, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAETIMEDOUT:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot send socket data as socket timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEMSGSIZE:       ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::BufferTooSmall, error, "Cannot send socket data as buffer provided was too big, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          default:                ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "The send unexpectedly closed, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+        }
+      }
+    }
+
+  send_segmented_final:
+
+    if ((mMonitorWriteReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once full
+      mMonitor->monitorWrite(*this);
+
+    return static_cast<size_t>(result);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::receiveFromCoalesced(
+                                      IPAddress &outRemoteIP,
+                                      BYTE *ioBuffer,
+                                      size_t inBufferLengthInBytes,
+                                      size_t &outSegmentSizeInBytes,
+                                      bool *outWouldBlock,
+                                      ULONG inFlags,
+                                      int *outNoThrowErrorResult
+                                      ) const throw(
+                                                    Exceptions::InvalidSocket,
+                                                    Exceptions::WouldBlock,
+                                                    Exceptions::Shutdown,
+                                                    Exceptions::ConnectionReset,
+                                                    Exceptions::Timeout,
+                                                    Exceptions::BufferTooSmall,
+                                                    Exceptions::Unspecified
+                                                    )
+  {
+    internal::ignoreSigTermOnThread();
+
+    ssize_t result = 0;
+    if (outNoThrowErrorResult)
+      *outNoThrowErrorResult = 0;
+
+    if (NULL != outWouldBlock)
+      *outWouldBlock = false;
+
+    outSegmentSizeInBytes = 0;
+
+    // scope:
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      sockaddr_in6 address;
+      memset(&address, 0, sizeof(address));
+      address.sin6_family = AF_INET6;
+      socklen_t size = sizeof(address);
+      size_t segmentSize = 0;
+
+#ifdef HAVE_UDP_GSO
+      iovec buffer;
+      buffer.iov_base = ioBuffer;
+      buffer.iov_len = inBufferLengthInBytes;
+
+      char control[CMSG_SPACE(sizeof(int))];
+      memset(&(control[0]), 0, sizeof(control));
+
+      msghdr message;
+      memset(&message, 0, sizeof(message));
+      message.msg_name = &address;
+      message.msg_namelen = size;
+      message.msg_iov = &buffer;
+      message.msg_iovlen = 1;
+      message.msg_control = &(control[0]);
+      message.msg_controllen = sizeof(control);
+
+      result = recvmsg(mSocket, &message, static_cast<int>(inFlags));
+      if (SOCKET_ERROR != result) {
+        size = message.msg_namelen;
+        segmentSize = static_cast<size_t>(result);
+
+        for (cmsghdr *header = CMSG_FIRSTHDR(&message); NULL != header; header = CMSG_NXTHDR(&message, header)) {
+          if ((IPPROTO_UDP != header->cmsg_level) ||
+              (UDP_GRO != header->cmsg_type)) continue;
+
+          int value = 0;
+          memcpy(&value, CMSG_DATA(header), sizeof(value));
+          if (value > 0) segmentSize = static_cast<size_t>(value);
+        }
+      }
+#else
+      result = recvfrom(
+                        mSocket,
+                        (char *)ioBuffer,
+                        SafeInt<int>(inBufferLengthInBytes),
+                        SafeInt<int>(inFlags),
+                        (sockaddr *)&address,
+                        &size
+                        );
+      if (SOCKET_ERROR != result)
+        segmentSize = static_cast<size_t>(result);
+#endif //HAVE_UDP_GSO
+
+      ZS_EVENTING_7(x, i, Trace, SocketRecvFrom, zs, Socket, Receive, socket, socket, static_cast<uint64_t>(mSocket), ssize_t, result, result, ulong, flags, inFlags, buffer, buffer, ioBuffer, size, size, inBufferLengthInBytes, binary, address, &address, size, addressSize, size);
+      recordSystemCall(SOCKET_ERROR == result);
+      if (SOCKET_ERROR != result) recordReceived(static_cast<size_t>(result), getTotalSegments(static_cast<size_t>(result), segmentSize));
+
+      if (SOCKET_ERROR == result)
+      {
+        result = 0;
+
+        int error = handleError(outWouldBlock);
+        ZS_EVENTING_2(x, i, Trace, SocketWouldBlock, zs, Socket, Info, socket, socket, static_cast<uint64_t>(mSocket), bool, wouldBlock, NULL == outWouldBlock ? false : *outWouldBlock);
+        if (0 == error) goto receive_coalesced_final;
+
+        error = handleError(error, outNoThrowErrorResult);
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, NULL == outNoThrowErrorResult ? error : *outNoThrowErrorResult);
+        if (0 == error) return 0;
+
+        switch (error)
+        {
+          case WSAEINPROGRESS:
+          case WSAEWOULDBLOCK:
+          {
+            ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::WouldBlock, error, "Cannot receive socket data as socket would block, where socket id=" + (string((PTRNUMBER)mSocket)));
+            break;
+          }
+          case WSAESHUTDOWN:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Shutdown, error, "Cannot receive socket data as connection was shutdown, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAECONNRESET:     ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::ConnectionReset, error, "Cannot receive socket data as socket was abruptly closed, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAENETRESET:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot receive socket data as connection keep alive timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAETIMEDOUT:      ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Timeout, error, "Cannot receive socket data as socket timed out, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          case WSAEMSGSIZE:       ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::BufferTooSmall, error, "Cannot receive socket data as buffer provided was too small, where socket id=" + (string((PTRNUMBER)mSocket))); break;
+          default:                ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "The receive unexpectedly closed, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error))); break;
+        }
+      } else {
+        outRemoteIP = internal::toIPAddress(address, size);
+        outSegmentSizeInBytes = segmentSize;
+      }
+    }
+
+  receive_coalesced_final:
+
+    if ((mMonitorReadReady) &&
+        ((!mMonitorEdgeTriggered) || ((NULL != outWouldBlock) && (*outWouldBlock))))   // edge triggered sockets re-arm only once drained
+      mMonitor->monitorRead(*this);
+
+    return static_cast<size_t>(result);
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::getTotalSegments(
+                                  size_t inLengthInBytes,
+                                  size_t inSegmentSizeInBytes
+                                  )
+  {
+    if (0 == inLengthInBytes) return 0;
+    if ((0 == inSegmentSizeInBytes) || (inSegmentSizeInBytes >= inLengthInBytes)) return 1;
+    return (inLengthInBytes + inSegmentSizeInBytes - 1) / inSegmentSizeInBytes;
+  }
+
+  //---------------------------------------------------------------------------
+  size_t Socket::splitSegments(
+                               BYTE *inBuffer,
+                               size_t inLengthInBytes,
+                               size_t inSegmentSizeInBytes,
+                               BufferSpan *outSegments,
+                               size_t inMaxSegments
+                               )
+  {
+    size_t segmentSize = ((0 == inSegmentSizeInBytes) || (inSegmentSizeInBytes > inLengthInBytes) ? inLengthInBytes : inSegmentSizeInBytes);
+
+    size_t total = 0;
+    for (size_t offset = 0; (offset < inLengthInBytes) && (total < inMaxSegments); offset += segmentSize, ++total) {
+      outSegments[total].mBuffer = inBuffer + offset;
+      outSegments[total].mLengthInBytes = (inLengthInBytes - offset < segmentSize ? inLengthInBytes - offset : segmentSize);
+    }
+    return total;
+  }
+
+  //---------------------------------------------------------------------------
+  void Socket::shutdown(Shutdown::Options inOptions) const throw(Exceptions::InvalidSocket, Exceptions::Unspecified)
+  {
+    internal::ignoreSigTermOnThread();
+
+    {
+      AutoRecursiveLock lock(mLock);
+      ZS_THROW_CUSTOM_IF(Exceptions::InvalidSocket, !isValid())
+
+      int result = ::shutdown(mSocket, inOptions);
+      ZS_EVENTING_3(x, i, Debug, SocketShutdown, zs, Socket, Shutdown, socket, socket, static_cast<uint64_t>(mSocket), int, result, result, enum, options, to_underlying(inOptions));
+
+      if (SOCKET_ERROR == result)
+      {
+        int error = WSAGetLastError();
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(mSocket), int, error, error);
+        ZS_THROW_CUSTOM_PROPERTIES_1(Exceptions::Unspecified, error, "Failed to perform a shutdown on the socket, where socket id=" + (string((PTRNUMBER)mSocket)) + ", error=" + (string(error)))
+      }
+    }
+
+    if (mMonitorReadReady)
+      mMonitor->monitorRead(*this);
+    if (mMonitorWriteReady)
+      mMonitor->monitorWrite(*this);
+    if (mMonitorException)
+      mMonitor->monitorException(*this);
+  }
+
+  namespace internal
+  {
+    //-------------------------------------------------------------------------
+    static void setSocketOptions(
+                                 SOCKET inSocket,
+                                 int inLevel,
+                                 int inOptionName,
+                                 BYTE *inOptionValue,
+                                 socklen_t inOptionLength
+                                 )
+    {
+      int result = ::setsockopt(inSocket, inLevel, inOptionName, (const char *)inOptionValue, inOptionLength);
+      ZS_EVENTING_6(x, i, Debug, SocketSetOption, zs, Socket, Option, socket, socket, static_cast<uint64_t>(inSocket), int, result, result, int, level, inLevel, int, optionName, inOptionName, binary, optionValue, inOptionValue, size, optionValueSize, inOptionLength);
+
+      if (SOCKET_ERROR == result)
+      {
+        int error = WSAGetLastError();
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(inSocket), int, error, error);
+        ZS_THROW_CUSTOM_PROPERTIES_1(zsLib::Socket::Exceptions::Unspecified, error, "setsockopt failed, where socket id=" + (string((PTRNUMBER)inSocket)) + ", socket option=" + (string(inOptionName)) + ", error=" + (string(error)))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    static void getSocketOptions(
+                                 SOCKET inSocket,
+                                 int inLevel,
+                                 int inOptionName,
+                                 BYTE *outOptionValue,
+                                 socklen_t inOptionLength
+                                 )
+    {
+      socklen_t length = inOptionLength;
+      int result = ::getsockopt(inSocket, inLevel, inOptionName, (char *)outOptionValue, &length);
+      ZS_EVENTING_6(x, i, Debug, SocketGetOptions, zs, Socket, Option, socket, socket, static_cast<uint64_t>(inSocket), int, result, result, int, level, inLevel, int, optionName, inOptionName, binary, optionValue, outOptionValue, size, optionValueSize, inOptionLength);
+
+      if (SOCKET_ERROR == result)
+      {
+        int error = WSAGetLastError();
+        ZS_EVENTING_2(x, e, Detail, SocketError, zs, Socket, Exception, socket, socket, static_cast<uint64_t>(inSocket), int, error, error);
+        ZS_THROW_CUSTOM_PROPERTIES_1(zsLib::Socket::Exceptions::Unspecified, error, "getsockopt failed, where socket id=" + (string((PTRNUMBER)inSocket)) + ", socket option=" + (string(inOptionName)) + ", error=" + (string(error)))
+      }
+      ZS_THROW_BAD_STATE_IF(length != inOptionLength)
+    }
+
+  } // namespace internal
 
   //---------------------------------------------------------------------------
   void Socket::setOptionFlag(Socket::SetOptionFlag::Options inOption, bool inEnabled) const throw(
@@ -1307,6 +3052,8 @@ namespace zsLib
     int level = SOL_SOCKET;
     if (SetOptionFlag::TCPNoDelay == inOption)
       level = IPPROTO_TCP;
+    if (SetOptionFlag::UDPReceiveCoalescing == inOption)
+      level = IPPROTO_UDP;
 
 #ifdef _WIN32
     BOOL value = (inEnabled ? 1 : 0);
@@ -1314,6 +3061,9 @@ namespace zsLib
     int value = (inEnabled ? 1 : 0);
 #endif //_WIN32
     internal::setSocketOptions(mSocket, level, static_cast<int>(inOption), (BYTE *)&value, sizeof(value));
+
+    if (SetOptionFlag::ZeroCopy == inOption)
+      mZeroCopyEnabled = inEnabled;
   }
 
   //---------------------------------------------------------------------------
@@ -1339,8 +3089,12 @@ namespace zsLib
       return;
     }
 
+    int level = SOL_SOCKET;
+    if (SetOptionValue::UDPSegmentSizeInBytes == inOption)
+      level = IPPROTO_UDP;
+
     int value = static_cast<int>(inValue);
-    internal::setSocketOptions(mSocket, SOL_SOCKET, inOption, (BYTE *)&value, sizeof(value));
+    internal::setSocketOptions(mSocket, level, inOption, (BYTE *)&value, sizeof(value));
   }
 
   //---------------------------------------------------------------------------
@@ -1378,6 +3132,8 @@ namespace zsLib
     int level = SOL_SOCKET;
     if (GetOptionFlag::IsTCPNoDelay == inOption)
       level = IPPROTO_TCP;
+    if (GetOptionFlag::IsUDPReceiveCoalescing == inOption)
+      level = IPPROTO_UDP;
 
 #ifdef _WIN32
     BOOL value = 0;
@@ -1422,6 +3178,9 @@ namespace zsLib
     }
 
     int level = SOL_SOCKET;
+    if (GetOptionValue::UDPSegmentSizeInBytes == inOption)
+      level = IPPROTO_UDP;
+
     int value_int = 0;
     unsigned int value_unsigned_int = 0;
 
@@ -1490,6 +3249,136 @@ namespace zsLib
     }
   }
 
+  //---------------------------------------------------------------------------
+  //---------------------------------------------------------------------------
+  //---------------------------------------------------------------------------
+  //---------------------------------------------------------------------------
+  #pragma mark
+  #pragma mark SocketShardedListener
+  #pragma mark
+
+  //---------------------------------------------------------------------------
+  SocketShardedListener::~SocketShardedListener()
+  {
+    close();
+  }
+
+  //---------------------------------------------------------------------------
+  SocketShardedListenerPtr SocketShardedListener::create(
+                                                         const IPAddress &inBindIP,
+                                                         size_t inTotalShards,
+                                                         bool inSteerIncomingCPU
+                                                         ) throw (
+                                                                  Socket::Exceptions::AddressInUse,
+                                                                  Socket::Exceptions::UnsupportedSocketOption,
+                                                                  Socket::Exceptions::Unspecified
+                                                                  )
+  {
+    size_t totalCPUs = std::thread::hardware_concurrency();
+    if (0 == totalCPUs) totalCPUs = 1;
+    if (0 == inTotalShards) inTotalShards = totalCPUs;
+
+    SocketShardedListenerPtr pThis(new SocketShardedListener);
+
+    IPAddress bindIP(inBindIP);
+
+    try {
+      for (size_t index = 0; index < inTotalShards; ++index) {
+        SocketPtr socket = Socket::createTCP(bindIP.isIPv4() ? Socket::Create::IPv4 : Socket::Create::IPv6);
+        socket->relinkSocketMonitor(internal::SocketMonitor::linkShard(index));
+
+        socket->setOptionFlag(Socket::SetOptionFlag::NonBlocking, true);
+        socket->setOptionFlag(Socket::SetOptionFlag::ReuseAddress, true);
+        if (inTotalShards > 1)
+          socket->setOptionFlag(Socket::SetOptionFlag::ReusePort, true);
+
+        int incomingCPU = -1;
+        if (inSteerIncomingCPU) {
+          incomingCPU = static_cast<int>(index % totalCPUs);
+          socket->setOptionValue(Socket::SetOptionValue::IncomingCPU, static_cast<ULONG>(incomingCPU));
+        }
+
+        socket->bind(bindIP);
+        if (0 == index) {
+          bindIP = socket->getLocalAddress();                                       // every other shard binds to the same port
+          pThis->mLocalAddress = bindIP;
+        }
+        socket->listen();
+
+        pThis->mShards.push_back(socket);
+        pThis->mIncomingCPUs.push_back(incomingCPU);
+      }
+    } catch (...) {
+      pThis->close();
+      throw;
+    }
+
+    ZS_LOG_DETAIL(internal::slog("sharded listener created") + ZS_PARAM("address", pThis->mLocalAddress.string()) + ZS_PARAM("shards", inTotalShards) + ZS_PARAM("steer incoming cpu", inSteerIncomingCPU))
+
+    return pThis;
+  }
+
+  //---------------------------------------------------------------------------
+  SocketPtr SocketShardedListener::getShard(size_t inIndex) const
+  {
+    if (inIndex >= mShards.size()) return SocketPtr();
+    return mShards[inIndex];
+  }
+
+  //---------------------------------------------------------------------------
+  void SocketShardedListener::setDelegate(
+                                          size_t inIndex,
+                                          ISocketDelegatePtr delegate
+                                          ) throw (Socket::Exceptions::InvalidSocket)
+  {
+    SocketPtr socket = getShard(inIndex);
+    ZS_THROW_INVALID_ARGUMENT_IF(!socket)
+
+    socket->monitor(Socket::Monitor::Read);
+    socket->setDelegate(delegate);
+  }
+
+  //---------------------------------------------------------------------------
+  SocketShardedListener::ShardList SocketShardedListener::getShards() const
+  {
+    ShardList result;
+
+    for (size_t index = 0; index < mShards.size(); ++index) {
+      auto &socket = mShards[index];
+
+      Shard shard;
+      shard.mIndex = index;
+      shard.mSocket = socket;
+      shard.mMonitorID = (socket->mMonitor ? socket->mMonitor->getID() : 0);
+      shard.mIncomingCPU = mIncomingCPUs[index];
+      shard.mTotalAccepted = socket->mStatistics.mAccepted;
+      result.push_back(shard);
+    }
+
+    return result;
+  }
+
+  //---------------------------------------------------------------------------
+  size_t SocketShardedListener::getTotalAccepted() const
+  {
+    size_t total = 0;
+    for (auto iter = mShards.begin(); iter != mShards.end(); ++iter) {
+      total += (*iter)->mStatistics.mAccepted;
+    }
+    return total;
+  }
+
+  //---------------------------------------------------------------------------
+  void SocketShardedListener::close()
+  {
+    for (auto iter = mShards.begin(); iter != mShards.end(); ++iter) {
+      try {
+        (*iter)->close();
+      } catch (Socket::Exceptions::Unspecified &) {
+      }
+    }
+  }
+
 } // namespace zsLib
 
 #pragma warning(pop)
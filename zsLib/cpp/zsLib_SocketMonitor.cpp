@@ -32,6 +32,12 @@
 #include <zsLib/internal/zsLib_SocketMonitor.h>
 #include <zsLib/internal/zsLib_MessageQueueThread.h>
 
+#ifndef ZSLIB_EVENTING_NOOP
+#include <zsLib/internal/zsLib.events.h>
+#else
+#include <zsLib/eventing/noop.h>
+#endif //ndef ZSLIB_EVENTING_NOOP
+
 #include <zsLib/ISettings.h>
 #include <zsLib/Stringize.h>
 #include <zsLib/helpers.h>
@@ -41,9 +47,39 @@
 
 #include <stdlib.h>
 
+#include <limits>
 #include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif //ndef _WIN32
+
+#ifdef HAVE_EVENTFD
+#include <sys/eventfd.h>
+#endif //HAVE_EVENTFD
+
+#if (defined HAVE_PTHREAD_SETAFFINITY_NP) || (defined HAVE_PTHREAD_GETCPUCLOCKID)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif //(defined HAVE_PTHREAD_SETAFFINITY_NP) || (defined HAVE_PTHREAD_GETCPUCLOCKID)
+
+#ifdef HAVE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif //HAVE_IO_URING
 
 #define ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS (10*(1000))
+#define ZSLIB_SOCKET_MONITOR_EPOLL_MAX_EVENTS (256)
+#define ZSLIB_SOCKET_MONITOR_IDLE_CHECK_DIVISOR (8)
+#define ZSLIB_SOCKET_MONITOR_IDLE_CHECK_MIN_INTERVAL_IN_MILLISECONDS (10)
+
+#define ZSLIB_SOCKET_COMPLETION_DEFAULT_QUEUE_DEPTH (256)
+#define ZSLIB_SOCKET_COMPLETION_WAKE_UP_USER_DATA (0ULL)
+#define ZSLIB_SOCKET_COMPLETION_IGNORE_USER_DATA (~0ULL)
+#define ZSLIB_SOCKET_COMPLETION_POLL_USER_DATA_FLAG (1ULL << 63)
 
 namespace zsLib {ZS_DECLARE_SUBSYSTEM(zsLib_socket)}
 
@@ -93,6 +129,18 @@ namespace zsLib
       return String((CSTR)(&(positions[0])));
     }
 
+    //-------------------------------------------------------------------------
+    static IPAddress toIPAddress(const sockaddr_in6 &address, socklen_t size)
+    {
+      switch (size)
+      {
+        case sizeof(sockaddr_in):  return IPAddress((const sockaddr_in &)address);
+        case sizeof(sockaddr_in6):
+        default:                   break;
+      }
+      return IPAddress(address);
+    }
+
     //-----------------------------------------------------------------------
 #ifdef _WIN32
     static zsLib::Log::Params slog(const char *message, const char *object)
@@ -138,6 +186,12 @@ namespace zsLib
       virtual void notifySettingsApplyDefaults() override
       {
         ISettings::setString(ZSLIB_SETTING_SOCKET_MONITOR_THREAD_PRIORITY, "normal");
+        ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL, true);
+        ISettings::setUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS, 0);
+        ISettings::setString(ZSLIB_SETTING_SOCKET_MONITOR_ASSIGNMENT, "load");
+        ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_DISABLE_EVENTFD, false);
+        ISettings::setString(ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE, "io_uring");
+        ISettings::setUInt(ZSLIB_SETTING_SOCKET_COMPLETION_QUEUE_DEPTH, ZSLIB_SOCKET_COMPLETION_DEFAULT_QUEUE_DEPTH);
       }
     };
 
@@ -164,10 +218,13 @@ namespace zsLib
       struct SocketMonitorInfo
       {
         size_t totalMonitored_ {};
+        bool reactor_ {};
+        bool busyPoll_ {};
         SocketMonitorPtr monitor_;
       };
 
       typedef std::unordered_map<PUID, SocketMonitorInfo> SocketMonitorMap;
+      typedef std::vector<PUID> ReactorList;
 
     protected:
 
@@ -220,12 +277,33 @@ namespace zsLib
       }
 
       //-----------------------------------------------------------------------
-      static SocketMonitorPtr link()
+      static SocketMonitorPtr link(PTRNUMBER hashValue)
+      {
+        auto pThis = singleton();
+        if (!pThis) return SocketMonitorPtr();
+
+        return pThis->internalLink(hashValue);
+      }
+
+      //-----------------------------------------------------------------------
+      static SocketMonitorPtr linkShard(size_t shardIndex)
+      {
+        auto pThis = singleton();
+        if (!pThis) return SocketMonitorPtr();
+
+        return pThis->internalLinkShard(shardIndex);
+      }
+
+      //-----------------------------------------------------------------------
+      static SocketMonitorPtr linkBusyPoll(
+                                           int cpu,
+                                           Microseconds spinTimeout
+                                           )
       {
         auto pThis = singleton();
         if (!pThis) return SocketMonitorPtr();
 
-        return pThis->internalLink();
+        return pThis->internalLinkBusyPoll(cpu, spinTimeout);
       }
 
       //-----------------------------------------------------------------------
@@ -237,6 +315,15 @@ namespace zsLib
         pThis->internalUnlink(id);
       }
 
+      //-----------------------------------------------------------------------
+      static zsLib::Socket::MonitorLoadList getLoads()
+      {
+        auto pThis = singleton();
+        if (!pThis) return zsLib::Socket::MonitorLoadList();
+
+        return pThis->internalGetLoads();
+      }
+
     protected:
 
       //-----------------------------------------------------------------------
@@ -268,6 +355,7 @@ namespace zsLib
 
           monitors = socketMonitors_;
           socketMonitors_.clear();
+          reactors_.clear();
         }
 
         for (auto iter = monitors.begin(); iter != monitors.end(); ++iter) {
@@ -280,14 +368,99 @@ namespace zsLib
       }
 
       //-----------------------------------------------------------------------
-      SocketMonitorPtr internalLink()
+      void loadReactorSettings()
+      {
+        // only re-read while nothing is linked so a socket never moves
+        if (0 != totalLinked_) return;
+
+        size_t totalReactors = SafeInt<size_t>(ISettings::getUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS));
+        assignByHash_ = (ISettings::getString(ZSLIB_SETTING_SOCKET_MONITOR_ASSIGNMENT) == "hash");
+
+        if (totalReactors == totalReactors_) return;
+
+        ZS_LOG_DETAIL(slog("reactor settings changed") + ZS_PARAM("total", totalReactors) + ZS_PARAM("was", totalReactors_) + ZS_PARAM("hash", assignByHash_))
+
+        totalReactors_ = totalReactors;
+
+        for (auto iter = reactors_.begin(); iter != reactors_.end(); ++iter) {
+          auto found = socketMonitors_.find(*iter);
+          if (found == socketMonitors_.end()) continue;
+
+          SocketMonitorPtr shutdownMonitor = (*found).second.monitor_;
+          socketMonitors_.erase(found);
+
+          try {
+            shutdownQueue_->postClosure([shutdownMonitor]()
+            {
+              shutdownMonitor->shutdown();
+            });
+          } catch (IMessageQueue::Exceptions::MessageQueueGone &) {
+          }
+        }
+        reactors_.clear();
+      }
+
+      //-----------------------------------------------------------------------
+      void createReactors()
+      {
+        while (reactors_.size() < totalReactors_) {
+          SocketMonitorInfo info;
+          info.monitor_ = SocketMonitor::create();
+          info.reactor_ = true;
+
+          reactors_.push_back(info.monitor_->getID());
+          socketMonitors_[info.monitor_->getID()] = info;
+        }
+      }
+
+      //-----------------------------------------------------------------------
+      SocketMonitorInfo *findReactor(PTRNUMBER hashValue)
+      {
+        createReactors();
+
+        if (assignByHash_) {
+          hashValue = hashValue ^ (hashValue >> 7) ^ (hashValue >> 17);
+          return &(socketMonitors_[reactors_[hashValue % reactors_.size()]]);
+        }
+
+        SocketMonitorInfo *foundInfo {};
+        for (auto iter = reactors_.begin(); iter != reactors_.end(); ++iter) {
+          auto &info = socketMonitors_[(*iter)];
+          if ((foundInfo) &&
+              (info.totalMonitored_ >= foundInfo->totalMonitored_)) continue;
+          foundInfo = &info;
+        }
+        return foundInfo;
+      }
+
+      //-----------------------------------------------------------------------
+      SocketMonitorPtr internalLink(PTRNUMBER hashValue)
       {
         AutoRecursiveLock lock(lock_);
 
+        loadReactorSettings();
+
+        ++totalLinked_;
+
+        if (totalReactors_ > 0) {
+          SocketMonitorInfo *reactorInfo = findReactor(hashValue);
+#ifdef _WIN32
+          if (reactorInfo->totalMonitored_ >= maxSocketsFor(*reactorInfo)) {
+            reactorInfo = NULL;   // wait events are limited per thread so overflow to an on demand monitor
+          }
+          if (reactorInfo)
+#endif //_WIN32
+          {
+            ++(reactorInfo->totalMonitored_);
+            return reactorInfo->monitor_;
+          }
+        }
+
         SocketMonitorInfo *foundInfo {};
 
         for (auto iter = socketMonitors_.begin(); iter != socketMonitors_.end(); ++iter) {
           auto &info = (*iter).second;
+          if (info.busyPoll_) continue;                                               // only opted in sockets are busy polled
 
           if (!foundInfo) {
             foundInfo = &info;
@@ -299,7 +472,7 @@ namespace zsLib
         }
 
         if (foundInfo) {
-          if (foundInfo->totalMonitored_ >= maxSocketsPerMonitor_) {
+          if (foundInfo->totalMonitored_ >= maxSocketsFor(*foundInfo)) {
             foundInfo = NULL;
           }
         }
@@ -318,6 +491,77 @@ namespace zsLib
         return info.monitor_;
       }
 
+      //-----------------------------------------------------------------------
+      size_t maxSocketsFor(const SocketMonitorInfo &info) const
+      {
+        // an epoll backed monitor has no per thread descriptor limit thus
+        // every socket can share a single thread
+        if (info.monitor_->isUsingEpoll()) return std::numeric_limits<size_t>::max();
+        return maxSocketsPerMonitor_;
+      }
+
+      //-----------------------------------------------------------------------
+      SocketMonitorPtr internalLinkShard(size_t shardIndex)
+      {
+        AutoRecursiveLock lock(lock_);
+
+        loadReactorSettings();
+
+        ++totalLinked_;
+
+        if (totalReactors_ > 0) {
+          createReactors();
+
+          auto &info = socketMonitors_[reactors_[shardIndex % reactors_.size()]];
+          ++(info.totalMonitored_);
+          return info.monitor_;
+        }
+
+        // every shard gets a monitor of its own so shards never share a thread
+        SocketMonitorInfo info;
+        info.monitor_ = SocketMonitor::create();
+        info.totalMonitored_ = 1;
+
+        socketMonitors_[info.monitor_->getID()] = info;
+
+        return info.monitor_;
+      }
+
+      //-----------------------------------------------------------------------
+      SocketMonitorPtr internalLinkBusyPoll(
+                                            int cpu,
+                                            Microseconds spinTimeout
+                                            )
+      {
+        AutoRecursiveLock lock(lock_);
+
+        ++totalLinked_;
+
+        // every busy poll thread consumes a core thus sockets wanting the
+        // same CPU share one thread
+        for (auto iter = socketMonitors_.begin(); iter != socketMonitors_.end(); ++iter) {
+          auto &info = (*iter).second;
+          if (!info.busyPoll_) continue;
+          if (info.monitor_->getBusyPollCPU() != cpu) continue;
+
+          info.monitor_->setBusyPoll(cpu, spinTimeout);
+          ++(info.totalMonitored_);
+          return info.monitor_;
+        }
+
+        SocketMonitorInfo info;
+        info.monitor_ = SocketMonitor::create();
+        info.monitor_->setBusyPoll(cpu, spinTimeout);
+        info.busyPoll_ = true;
+        info.totalMonitored_ = 1;
+
+        socketMonitors_[info.monitor_->getID()] = info;
+
+        ZS_LOG_DETAIL(slog("created busy poll monitor") + ZS_PARAM("monitor", info.monitor_->getID()) + ZS_PARAM("cpu", cpu) + ZS_PARAM("spin timeout", spinTimeout))
+
+        return info.monitor_;
+      }
+
       //-----------------------------------------------------------------------
       void internalUnlink(PUID id)
       {
@@ -333,9 +577,11 @@ namespace zsLib
 
           if (info.totalMonitored_ > 0) {
             --(info.totalMonitored_);
+            --totalLinked_;
           }
 
-          if (0 == info.totalMonitored_) {
+          if ((0 == info.totalMonitored_) &&
+              (!info.reactor_)) {
             shutdownMonitor = info.monitor_;
             socketMonitors_.erase(found);
           }
@@ -352,6 +598,37 @@ namespace zsLib
         }
       }
 
+      //-----------------------------------------------------------------------
+      zsLib::Socket::MonitorLoadList internalGetLoads()
+      {
+        AutoRecursiveLock lock(lock_);
+
+        zsLib::Socket::MonitorLoadList result;
+
+        for (auto iter = socketMonitors_.begin(); iter != socketMonitors_.end(); ++iter) {
+          auto &info = (*iter).second;
+
+          zsLib::Socket::MonitorLoad load;
+          load.mMonitorID = info.monitor_->getID();
+          load.mReactor = info.reactor_;
+          load.mTotalSockets = info.totalMonitored_;
+          load.mTotalWaits = info.monitor_->getTotalWaits();
+          load.mTotalEvents = info.monitor_->getTotalEvents();
+          load.mTotalActiveWaits = info.monitor_->getTotalActiveWaits();
+          load.mMaxEventsPerWait = info.monitor_->getMaxEventsPerWait();
+          load.mTotalRebuilds = info.monitor_->getTotalRebuilds();
+          load.mTotalWakeUps = info.monitor_->getTotalWakeUps();
+          load.mBusyPoll = info.busyPoll_;
+          load.mBusyPollCPU = info.monitor_->getBusyPollCPU();
+          load.mTotalSpinWaits = info.monitor_->getTotalSpinWaits();
+          load.mThreadCPUTime = info.monitor_->getThreadCPUTime();
+          load.mThreadRunTime = info.monitor_->getThreadRunTime();
+          result.push_back(load);
+        }
+
+        return result;
+      }
+
       //-----------------------------------------------------------------------
       static zsLib::Log::Params slog(const char *message)
       {
@@ -367,6 +644,12 @@ namespace zsLib
 
       size_t maxSocketsPerMonitor_ {};
       SocketMonitorMap socketMonitors_;
+
+      size_t totalLinked_ {};
+      size_t totalReactors_ {};
+      bool assignByHash_ {};
+      ReactorList reactors_;
+
       IMessageQueueThreadPtr shutdownQueue_;
     };
 
@@ -381,6 +664,20 @@ namespace zsLib
     //-------------------------------------------------------------------------
     SocketSet::SocketSet()
     {
+#ifdef HAVE_EPOLL
+      if (ISettings::getBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL)) {
+        mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+        if (-1 == mEpollFD) {
+          ZS_LOG_WARNING(Basic, log("unable to create epoll (falling back to poll)") + ZS_PARAM("error", errno))
+        } else {
+          mDirty = false;
+          mEpollAllocationSize = ZSLIB_SOCKET_MONITOR_EPOLL_MAX_EVENTS;
+          mEpollEvents = new struct epoll_event[mEpollAllocationSize] {};
+          ZS_LOG_BASIC(log("created (using epoll)") + ZS_PARAM("epoll", mEpollFD))
+          return;
+        }
+      }
+#endif //HAVE_EPOLL
       ZS_LOG_BASIC(log("created"))
     }
 
@@ -403,6 +700,15 @@ namespace zsLib
       delete [] mPollingFiredEvents;
       delete [] mPollingSocketsWithDelegateGone;
 
+#ifdef HAVE_EPOLL
+      if (-1 != mEpollFD) {
+        ::close(mEpollFD);
+        mEpollFD = -1;
+      }
+      delete [] mEpollEvents;
+      mEpollAllocationSize = 0;
+#endif //HAVE_EPOLL
+
       mOfficialAllocationSize = 0;
       mOfficialCount = 0;
 
@@ -439,6 +745,16 @@ namespace zsLib
         mPollingSocketsWithDelegateGoneCount = 0;
       }
 
+#ifdef HAVE_EPOLL
+      if (usingEpoll()) {
+        // only the ready sockets are filled in by "waitEpoll()"
+        minPollingAllocation(mEpollAllocationSize);
+        mPollingCount = 0;
+        outSize = 0;
+        return mPollingSet;
+      }
+#endif //HAVE_EPOLL
+
       if (!mDirty) {
         for (poll_size index = 0; index < mPollingCount; ++index) {
           mPollingSet[index].revents = 0; // reset events
@@ -465,6 +781,7 @@ namespace zsLib
       }
 
       mDirty = false;
+      ++mTotalRebuilds;
 
       ZS_LOG_INSANE(log("preparing polling") + ZS_PARAM("count", mOfficialCount) + ZS_PARAM("allocated", mOfficialAllocationSize))
 
@@ -531,7 +848,79 @@ namespace zsLib
 
       mOfficialCount = 0;
       mSocketIndexes.clear();
+
+#ifdef HAVE_EPOLL
+      for (auto iter = mEpollSockets.begin(); iter != mEpollSockets.end(); ++iter) {
+        struct epoll_event event {};
+        epoll_ctl(mEpollFD, EPOLL_CTL_DEL, (*iter).first, &event);
+      }
+      mEpollSockets.clear();
+      mEpollEdgeTriggered.clear();
+#endif //HAVE_EPOLL
+    }
+
+    //-------------------------------------------------------------------------
+    bool SocketSet::supportsEdgeTriggered() const
+    {
+#ifdef HAVE_EPOLL
+      return usingEpoll();
+#else
+      return false;
+#endif //HAVE_EPOLL
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketSet::setEdgeTriggered(
+                                     SOCKET socket,
+                                     bool edgeTriggered
+                                     )
+    {
+#ifdef HAVE_EPOLL
+      if (!usingEpoll()) return;
+
+      bool wasEdgeTriggered = (mEpollEdgeTriggered.end() != mEpollEdgeTriggered.find(socket));
+      if (wasEdgeTriggered == edgeTriggered) return;
+
+      if (edgeTriggered) {
+        mEpollEdgeTriggered.insert(socket);
+      } else {
+        mEpollEdgeTriggered.erase(socket);
+      }
+
+      auto found = mEpollSockets.find(socket);
+      if (found == mEpollSockets.end()) return;
+
+      event_type events = (*found).second;
+      mEpollSockets.erase(found);
+      updateEpoll(socket, events);  // re-register with the new trigger mode
+#endif //HAVE_EPOLL
+    }
+
+#ifdef HAVE_EPOLL
+    //-------------------------------------------------------------------------
+    int SocketSet::waitEpoll(
+                             poll_size &outSize,
+                             int timeoutInMilliseconds
+                             )
+    {
+      outSize = 0;
+      mPollingCount = 0;
+
+      int result = epoll_wait(mEpollFD, mEpollEvents, static_cast<int>(mEpollAllocationSize), timeoutInMilliseconds);
+      if (result <= 0) return result;
+
+      for (int index = 0; index < result; ++index) {
+        poll_fd &record = mPollingSet[index];
+        record.fd = mEpollEvents[index].data.fd;
+        record.events = 0;
+        record.revents = fromEpollEvents(mEpollEvents[index].events);
+      }
+
+      mPollingCount = static_cast<poll_size>(result);
+      outSize = mPollingCount;
+      return result;
     }
+#endif //HAVE_EPOLL
 
 #ifdef _WIN32
     //-------------------------------------------------------------------------
@@ -559,6 +948,13 @@ namespace zsLib
     {
       ZS_LOG_INSANE(log("reset") + ZS_PARAM("handle", socket))
 
+#ifdef HAVE_EPOLL
+      if (usingEpoll()) {
+        removeEpoll(socket);
+        return;
+      }
+#endif //HAVE_EPOLL
+
       SocketIndexMap::iterator found = mSocketIndexes.find(socket);
       if (found == mSocketIndexes.end()) {
         return;  // socket is not found
@@ -624,6 +1020,13 @@ namespace zsLib
         return;
       }
 
+#ifdef HAVE_EPOLL
+      if (usingEpoll()) {
+        updateEpoll(socket, events);
+        return;
+      }
+#endif //HAVE_EPOLL
+
       SocketIndexMap::iterator found = mSocketIndexes.find(socket);
       if (found == mSocketIndexes.end()) {
         ZS_LOG_TRACE(log("reset did not find existing thus appending") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)))
@@ -648,6 +1051,14 @@ namespace zsLib
     {
       if (0 == events) return;  // noop
 
+#ifdef HAVE_EPOLL
+      if (usingEpoll()) {
+        auto found = mEpollSockets.find(socket);
+        updateEpoll(socket, (found == mEpollSockets.end() ? events : ((*found).second | events)));
+        return;
+      }
+#endif //HAVE_EPOLL
+
       SocketIndexMap::iterator found = mSocketIndexes.find(socket);
       if (found == mSocketIndexes.end()) {
         ZS_LOG_TRACE(log("add events did not find existing thus appending") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)))
@@ -674,6 +1085,24 @@ namespace zsLib
                                  event_type events
                                  )
     {
+#ifdef HAVE_EPOLL
+      if (usingEpoll()) {
+        auto found = mEpollSockets.find(socket);
+        if (found == mEpollSockets.end()) {
+          ZS_LOG_WARNING(Insane, log("remove events did not find existing") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)))
+          return;  // nothing to strip
+        }
+
+        event_type remaining = (*found).second & (~events);
+        if (0 == remaining) {
+          removeEpoll(socket);
+        } else {
+          updateEpoll(socket, remaining);
+        }
+        return;
+      }
+#endif //HAVE_EPOLL
+
       SocketIndexMap::iterator found = mSocketIndexes.find(socket);
       if (found == mSocketIndexes.end()) {
         ZS_LOG_WARNING(Insane, log("remove events did not find existing") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)))
@@ -699,6 +1128,21 @@ namespace zsLib
       }
     }
 
+    //-------------------------------------------------------------------------
+    void SocketSet::retriggerEvents(SOCKET socket)
+    {
+#ifdef HAVE_EPOLL
+      if (!usingEpoll()) return;
+
+      auto found = mEpollSockets.find(socket);
+      if (found == mEpollSockets.end()) return;
+
+      event_type events = (*found).second;
+      mEpollSockets.erase(found);
+      updateEpoll(socket, events);  // modifying an edge triggered socket reports it again if it is still ready
+#endif //HAVE_EPOLL
+    }
+
     //-------------------------------------------------------------------------
     void SocketSet::minOfficialAllocation(poll_size minSize)
     {
@@ -832,6 +1276,96 @@ namespace zsLib
     }
 #endif //_WIN32
 
+#ifdef HAVE_EPOLL
+    //-------------------------------------------------------------------------
+    void SocketSet::updateEpoll(
+                                SOCKET socket,
+                                event_type events
+                                )
+    {
+      auto found = mEpollSockets.find(socket);
+      bool exists = (found != mEpollSockets.end());
+      if ((exists) &&
+          ((*found).second == events)) return;  // nothing changed
+
+      struct epoll_event event {};
+      event.events = toEpollEvents(events);
+      event.data.fd = socket;
+      if (mEpollEdgeTriggered.end() != mEpollEdgeTriggered.find(socket)) {
+        event.events |= EPOLLET;
+      }
+
+      int result = epoll_ctl(mEpollFD, exists ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, socket, &event);
+      if (-1 == result) {
+        // closing a socket silently removes it from epoll thus a reused
+        // handle may no longer (or may already) be registered
+        if ((exists) && (ENOENT == errno)) {
+          result = epoll_ctl(mEpollFD, EPOLL_CTL_ADD, socket, &event);
+        } else if ((!exists) && (EEXIST == errno)) {
+          result = epoll_ctl(mEpollFD, EPOLL_CTL_MOD, socket, &event);
+        }
+      }
+
+      if (-1 == result) {
+        ZS_LOG_WARNING(Detail, log("unable to update epoll") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)) + ZS_PARAM("error", errno))
+        if (exists) mEpollSockets.erase(found);
+        return;
+      }
+
+      ZS_LOG_INSANE(log("epoll updated") + ZS_PARAM("handle", socket) + ZS_PARAM("events", friendly(events)) + ZS_PARAM("existed", exists))
+
+      mEpollSockets[socket] = events;
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketSet::removeEpoll(SOCKET socket)
+    {
+      // the trigger mode is kept as a socket without any interest is still
+      // monitored (until ended) and must be re-added with the same mode
+      auto found = mEpollSockets.find(socket);
+      if (found == mEpollSockets.end()) return;
+
+      ZS_LOG_TRACE(log("epoll removing") + ZS_PARAM("handle", socket))
+
+      struct epoll_event event {};
+      epoll_ctl(mEpollFD, EPOLL_CTL_DEL, socket, &event);  // can fail if the socket was already closed
+
+      mEpollSockets.erase(found);
+    }
+
+    //-------------------------------------------------------------------------
+    uint32_t SocketSet::toEpollEvents(event_type events)
+    {
+      uint32_t result {};
+      if (0 != (POLLRDNORM & events)) {
+        result |= EPOLLIN;
+      }
+      if (0 != (POLLWRNORM & events)) {
+        result |= EPOLLOUT;
+      }
+      return result;  // EPOLLERR and EPOLLHUP are always reported
+    }
+
+    //-------------------------------------------------------------------------
+    SocketSet::event_type SocketSet::fromEpollEvents(uint32_t events)
+    {
+      event_type result {};
+      if (0 != (EPOLLIN & events)) {
+        result |= POLLRDNORM;
+      }
+      if (0 != (EPOLLOUT & events)) {
+        result |= POLLWRNORM;
+      }
+      if (0 != (EPOLLERR & events)) {
+        result |= POLLERR;
+      }
+      if (0 != (EPOLLHUP & events)) {
+        result |= POLLHUP;
+      }
+      return result;
+    }
+#endif //HAVE_EPOLL
+
     //-----------------------------------------------------------------------
     zsLib::Log::Params SocketSet::log(const char *message) const
     {
@@ -906,9 +1440,24 @@ namespace zsLib
     }
 
     //-------------------------------------------------------------------------
-    SocketMonitorPtr SocketMonitor::link()
+    SocketMonitorPtr SocketMonitor::link(PTRNUMBER hashValue)
     {
-      return SocketMonitorLoadBalancer::link();
+      return SocketMonitorLoadBalancer::link(hashValue);
+    }
+
+    //-------------------------------------------------------------------------
+    SocketMonitorPtr SocketMonitor::linkShard(size_t shardIndex)
+    {
+      return SocketMonitorLoadBalancer::linkShard(shardIndex);
+    }
+
+    //-------------------------------------------------------------------------
+    SocketMonitorPtr SocketMonitor::linkBusyPoll(
+                                                 int cpu,
+                                                 Microseconds spinTimeout
+                                                 )
+    {
+      return SocketMonitorLoadBalancer::linkBusyPoll(cpu, spinTimeout);
     }
 
     //-------------------------------------------------------------------------
@@ -917,54 +1466,78 @@ namespace zsLib
       SocketMonitorLoadBalancer::unlink(mID);
     }
 
+    //-------------------------------------------------------------------------
+    zsLib::Socket::MonitorLoadList SocketMonitor::getLoads()
+    {
+      return SocketMonitorLoadBalancer::getLoads();
+    }
+
     //-------------------------------------------------------------------------
     void SocketMonitor::monitorBegin(
                                      SocketPtr socket,
                                      bool monitorRead,
                                      bool monitorWrite,
-                                     bool monitorException
+                                     bool monitorException,
+                                     bool monitorEdgeTriggered
                                      )
     {
-      EventPtr event;
       {
-        {
-          AutoRecursiveLock lock(mLock);
+        AutoRecursiveLock lock(mLock);
 
-          if (!mThread) {
-            auto pThis = mThisWeak.lock();
-            mThread = ThreadPtr(new std::thread(std::ref(*(pThis.get()))));
-            setThreadPriority(mThread->native_handle(), zsLib::threadPriorityFromString(ISettings::getString(ZSLIB_SETTING_SOCKET_MONITOR_THREAD_PRIORITY)));
-          }
+        if (!mThread) {
+          auto pThis = mThisWeak.lock();
+          mThreadStarted = steadyNow();
+          mThread = ThreadPtr(new std::thread(std::ref(*(pThis.get()))));
+          setThreadPriority(mThread->native_handle(), zsLib::threadPriorityFromString(ISettings::getString(ZSLIB_SETTING_SOCKET_MONITOR_THREAD_PRIORITY)));
         }
+      }
 
-        mThreadReady.wait();
-
-        {
-          AutoRecursiveLock lock(mLock);
-          SOCKET socketHandle = socket->getSocket();
-          if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
-            return;
+      mThreadReady.wait();
 
-          mMonitoredSockets[socketHandle] = socket;                                       // remember the socket is monitored
+      AutoRecursiveLock lock(mLock);
+      SOCKET socketHandle = socket->getSocket();
+      if (INVALID_SOCKET == socketHandle)                                               // nothing to monitor
+        return;
 
-          event_type events = 0;
-          if (monitorRead) events = events | POLLRDNORM;
-          if (monitorWrite) events = events | POLLWRNORM;
-          if (monitorException) events = events | POLLERR | POLLHUP | POLLNVAL;
+      event_type events = 0;
+      if (monitorRead) events = events | POLLRDNORM;
+      if (monitorWrite) events = events | POLLWRNORM;
+      if (monitorException) events = events | POLLERR | POLLHUP | POLLNVAL;
+
+      ZS_LOG_INSANE(log("monitor begin") + ZS_PARAM("handle", socketHandle) + ZS_PARAM("events", friendly(events)))
+
+      auto &monitored = mMonitoredSockets[socketHandle];                                // remember the socket is monitored
+      monitored.mSocket = socket;
+      monitored.mEdgeTriggered = monitorEdgeTriggered;
+      monitored.mIdleTimeout = socket->getIdleTimeout();
+
+      bool idleCheckSooner = false;
+      if (Milliseconds() != monitored.mIdleTimeout) {
+        monitored.mLastActivity = coarseSteadyNow();
+        SteadyTime deadline = monitored.mLastActivity + monitored.mIdleTimeout;
+        if (deadline < mNextIdleCheck) {
+          mNextIdleCheck = deadline;
+          idleCheckSooner = true;
+        }
+      }
 
-          ZS_LOG_INSANE(log("monitor begin") + ZS_PARAM("handle", socketHandle) + ZS_PARAM("events", friendly(events)))
+      if ((0 != monitored.mGeneration) &&
+          (monitored.mGeneration <= mAppliedGeneration)) {
+        mSocketSet.setEdgeTriggered(socketHandle, monitorEdgeTriggered);
+        mSocketSet.reset(socketHandle, events);                                         // already part of the socket set
+        if ((mSocketSet.isDirty()) || (idleCheckSooner)) wakeUp();
+        return;
+      }
 
-          mSocketSet.reset(socketHandle, events);
+      // the registration is applied by the monitor thread before it next
+      // waits thus the caller never waits for the monitor thread
+      monitored.mGeneration = ++mRegistrationGeneration;
+      monitored.mPendingEvents = events;
+      monitored.mRegistrationQueued = true;
+      mPendingRegistrations.push_back(socketHandle);
 
-          event = zsLib::Event::create();
-          mWaitingForRebuildList.push_back(event);                                        // socket handles cane be reused so we must ensure that the socket handles are rebuilt before returning
-
-          wakeUp();
-        }
-      }
-      if (event)
-        event->wait();
-    }
+      wakeUp();
+    }
 
     //-------------------------------------------------------------------------
     void SocketMonitor::monitorEnd(zsLib::Socket &socket)
@@ -983,12 +1556,27 @@ namespace zsLib
           return;                                                                       // socket was not being monitored
         }
 
+        if ((*found).second.mGeneration > mAppliedGeneration) {
+          ZS_LOG_TRACE(log("monitor end cancelled pending registration") + ZS_PARAM("handle", socketHandle))
+          mMonitoredSockets.erase(found);                                               // never reached the socket set thus nothing to wait upon
+          return;
+        }
+
         ZS_LOG_TRACE(log("monitor end") + ZS_PARAM("handle", socketHandle))
 
         mSocketSet.reset(socketHandle);
+        mSocketSet.setEdgeTriggered(socketHandle, false);
 
         mMonitoredSockets.erase(found);                                                 // clear out the socket since it is no longer being monitored
 
+        if ((mThread) &&
+            (mThread->get_id() == std::this_thread::get_id())) {
+          // ended from within a notification (e.g. a direct delegate releasing
+          // the last reference to its socket); the monitor thread is not
+          // waiting on the socket set thus it is rebuilt before the next wait
+          return;
+        }
+
         event = zsLib::Event::create();
         mWaitingForRebuildList.push_back(event);                                        // socket handles cane be reused so we must ensure that the socket handles are rebuilt before returning
 
@@ -1008,14 +1596,26 @@ namespace zsLib
       if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
         return;
 
-      if (mMonitoredSockets.end() == mMonitoredSockets.find(socketHandle)) {
+      auto found = mMonitoredSockets.find(socketHandle);
+      if (mMonitoredSockets.end() == found) {
         // if the socket is not being monitored, then do nothing
         ZS_LOG_INSANE(log("monitor read but socket is not monitored") + ZS_PARAM("handle", socketHandle))
         return;
       }
 
+      if ((*found).second.mGeneration > mAppliedGeneration) {
+        (*found).second.mPendingEvents |= POLLRDNORM;                           // applied along with the pending registration
+        return;
+      }
+
+      if (((*found).second.mEdgeTriggered) &&
+          (mSocketSet.supportsEdgeTriggered())) {
+        return;                                                                         // edge triggered interest is never removed
+      }
+
       ZS_LOG_INSANE(log("monitor read") + ZS_PARAM("handle", socketHandle))
 
+      socket.recordRearm();
       mSocketSet.addEvents(socketHandle, POLLRDNORM);
 
       if (mSocketSet.isDirty()) {
@@ -1024,6 +1624,35 @@ namespace zsLib
       }
     }
 
+    //-------------------------------------------------------------------------
+    void SocketMonitor::retriggerRead(const zsLib::Socket &socket)
+    {
+      AutoRecursiveLock lock(mLock);
+
+      SOCKET socketHandle = socket.getSocket();
+      if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
+        return;
+
+      auto found = mMonitoredSockets.find(socketHandle);
+      if (mMonitoredSockets.end() == found) {
+        ZS_LOG_INSANE(log("retrigger read but socket is not monitored") + ZS_PARAM("handle", socketHandle))
+        return;
+      }
+
+      if ((!(*found).second.mEdgeTriggered) ||
+          (!mSocketSet.supportsEdgeTriggered())) {
+        monitorRead(socket);
+        return;
+      }
+
+      if ((*found).second.mGeneration > mAppliedGeneration) return;               // the pending registration reports the socket anyway
+
+      ZS_LOG_INSANE(log("retrigger read") + ZS_PARAM("handle", socketHandle))
+
+      socket.recordRearm();
+      mSocketSet.retriggerEvents(socketHandle);
+    }
+
     //-------------------------------------------------------------------------
     void SocketMonitor::monitorWrite(const zsLib::Socket &socket)
     {
@@ -1033,14 +1662,26 @@ namespace zsLib
       if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
         return;
 
-      if (mMonitoredSockets.end() == mMonitoredSockets.find(socketHandle)) {
+      auto found = mMonitoredSockets.find(socketHandle);
+      if (mMonitoredSockets.end() == found) {
         // if the socket is not being monitored, then do nothing
         ZS_LOG_INSANE(log("monitor write but socket is not monitored") + ZS_PARAM("handle", socketHandle))
         return;
       }
 
+      if ((*found).second.mGeneration > mAppliedGeneration) {
+        (*found).second.mPendingEvents |= POLLWRNORM;                           // applied along with the pending registration
+        return;
+      }
+
+      if (((*found).second.mEdgeTriggered) &&
+          (mSocketSet.supportsEdgeTriggered())) {
+        return;                                                                         // edge triggered interest is never removed
+      }
+
       ZS_LOG_INSANE(log("monitor write") + ZS_PARAM("handle", socketHandle))
 
+      socket.recordRearm();
       mSocketSet.addEvents(socketHandle, POLLWRNORM);
 
       if (mSocketSet.isDirty()) {
@@ -1058,14 +1699,21 @@ namespace zsLib
       if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
         return;
 
-      if (mMonitoredSockets.end() == mMonitoredSockets.find(socketHandle)) {
+      auto found = mMonitoredSockets.find(socketHandle);
+      if (mMonitoredSockets.end() == found) {
         // if the socket is not being monitored, then do nothing
         ZS_LOG_INSANE(log("monitor exception but socket is not monitored") + ZS_PARAM("handle", socketHandle))
         return;
       }
 
+      if ((*found).second.mGeneration > mAppliedGeneration) {
+        (*found).second.mPendingEvents |= (POLLERR | POLLHUP | POLLNVAL);       // applied along with the pending registration
+        return;
+      }
+
       ZS_LOG_INSANE(log("monitor exception") + ZS_PARAM("handle", socketHandle))
 
+      socket.recordRearm();
       mSocketSet.addEvents(socketHandle, POLLERR | POLLHUP | POLLNVAL);
 
       if (mSocketSet.isDirty()) {
@@ -1074,10 +1722,122 @@ namespace zsLib
       }
     }
 
+    //-------------------------------------------------------------------------
+    void SocketMonitor::setIdleTimeout(
+                                       const zsLib::Socket &socket,
+                                       Milliseconds timeout
+                                       )
+    {
+      AutoRecursiveLock lock(mLock);
+
+      SOCKET socketHandle = socket.getSocket();
+      if (INVALID_SOCKET == socketHandle)                                             // nothing to monitor
+        return;
+
+      auto found = mMonitoredSockets.find(socketHandle);
+      if (mMonitoredSockets.end() == found) {
+        ZS_LOG_INSANE(log("idle timeout but socket is not monitored") + ZS_PARAM("handle", socketHandle))
+        return;
+      }
+
+      auto &monitored = (*found).second;
+      monitored.mIdleTimeout = timeout;
+      if (Milliseconds() == timeout)
+        return;                                                                         // a stale check finds nothing to do
+
+      monitored.mLastActivity = coarseSteadyNow();
+
+      SteadyTime deadline = monitored.mLastActivity + timeout;
+      if (deadline >= mNextIdleCheck)
+        return;
+
+      ZS_LOG_TRACE(log("idle timeout checked sooner") + ZS_PARAM("handle", socketHandle) + ZS_PARAM("timeout", timeout))
+
+      mNextIdleCheck = deadline;
+      wakeUp();                                                                         // the current wait may outlast the deadline
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketMonitor::setBusyPoll(
+                                    int cpu,
+                                    Microseconds spinTimeout
+                                    )
+    {
+      AutoRecursiveLock lock(mLock);
+
+      if (!mBusyPoll) {
+        mBusyPollCPU = cpu;                                                             // set before the monitor thread starts
+        mBusyPollSpinTimeout = spinTimeout.count();
+        mBusyPoll = true;
+        return;
+      }
+
+      Microseconds current(mBusyPollSpinTimeout);
+      if (Microseconds() == current) return;                                          // already spinning forever
+
+      if ((Microseconds() == spinTimeout) ||
+          (spinTimeout > current)) {
+        mBusyPollSpinTimeout = spinTimeout.count();
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool SocketMonitor::isUsingEpoll() const
+    {
+#ifdef HAVE_EPOLL
+      return mSocketSet.usingEpoll();                                                 // decided when the socket set is constructed
+#else
+      return false;
+#endif //HAVE_EPOLL
+    }
+
+    //-------------------------------------------------------------------------
+    Microseconds SocketMonitor::getThreadCPUTime()
+    {
+      AutoRecursiveLock lock(mLock);
+      if (!mThread) return Microseconds();
+
+#ifdef HAVE_PTHREAD_GETCPUCLOCKID
+      clockid_t clockID {};
+      if (0 != pthread_getcpuclockid(mThread->native_handle(), &clockID)) return Microseconds();
+
+      struct timespec ts {};
+      if (0 != clock_gettime(clockID, &ts)) return Microseconds();                    // thread has exited
+      return std::chrono::duration_cast<Microseconds>(Seconds(ts.tv_sec) + Nanoseconds(ts.tv_nsec));
+#elif defined(_WIN32)
+      FILETIME creationTime {};
+      FILETIME exitTime {};
+      FILETIME kernelTime {};
+      FILETIME userTime {};
+      if (!GetThreadTimes(mThread->native_handle(), &creationTime, &exitTime, &kernelTime, &userTime)) return Microseconds();
+
+      ULARGE_INTEGER kernel {};
+      ULARGE_INTEGER user {};
+      kernel.LowPart = kernelTime.dwLowDateTime;
+      kernel.HighPart = kernelTime.dwHighDateTime;
+      user.LowPart = userTime.dwLowDateTime;
+      user.HighPart = userTime.dwHighDateTime;
+      return Microseconds((kernel.QuadPart + user.QuadPart) / 10);                 // 100 nanosecond units
+#else
+      return Microseconds();
+#endif //HAVE_PTHREAD_GETCPUCLOCKID
+    }
+
+    //-------------------------------------------------------------------------
+    Microseconds SocketMonitor::getThreadRunTime()
+    {
+      AutoRecursiveLock lock(mLock);
+      if (!mThread) return Microseconds();
+
+      return std::chrono::duration_cast<Microseconds>(steadyNow() - mThreadStarted);
+    }
+
     //-------------------------------------------------------------------------
     void SocketMonitor::operator()()
     {
-      debugSetCurrentThreadName("org.zsLib.socketMonitor");
+      debugSetCurrentThreadName(mBusyPoll ? "org.zsLib.socketMonitor.busyPoll" : "org.zsLib.socketMonitor");
+
+      if (mBusyPoll) pinBusyPollThread();
 
       srand(static_cast<unsigned int>(time(NULL)));
 
@@ -1092,24 +1852,34 @@ namespace zsLib
         EventHandle *pollEvents = NULL;
         poll_fd *pollFDs = NULL;
         poll_size size = 0;
+        int waitTimeout = ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS;
 
         {
           AutoRecursiveLock lock(mLock);
           processWaiting();
+          applyRegistrations();
 
           pollFDs = mSocketSet.preparePollingFDs(size, pollEvents);
+          waitTimeout = getWaitTimeout();
+          if (0 == waitTimeout) ++mTotalSpinWaits;
 
-          ZS_LOG_INSANE(log("prepared FDs") + ZS_PARAM("total", size))
+          ZS_LOG_INSANE(log("prepared FDs") + ZS_PARAM("total", size) + ZS_PARAM("timeout", waitTimeout))
         }
 
         int lastError {};
 
-        auto result =
-
 #ifdef _WIN32
-        WSAWaitForMultipleEvents(SafeInt<DWORD>(size), pollEvents, FALSE, ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS, FALSE);
+        auto result = WSAWaitForMultipleEvents(SafeInt<DWORD>(size), pollEvents, FALSE, static_cast<DWORD>(waitTimeout), FALSE);
 #else
-        poll(pollFDs, size, ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS);
+        int result = 0;
+#ifdef HAVE_EPOLL
+        if (mSocketSet.usingEpoll()) {
+          result = mSocketSet.waitEpoll(size, waitTimeout);                              // only the ready sockets are returned
+        } else
+#endif //HAVE_EPOLL
+        {
+          result = poll(pollFDs, size, waitTimeout);
+        }
         if (-1 == result) {
           lastError = errno;
         }
@@ -1117,12 +1887,16 @@ namespace zsLib
 
         ZS_LOG_INSANE(log("poll completed") + ZS_PARAM("result", result) + ZS_PARAM("error", lastError));
 
+        ++mTotalWaits;
+
         bool redoWakeupSocket = false;
 
         // select completed, do notifications from select
         {
           AutoRecursiveLock lock(mLock);
 
+          SteadyTime activityTime = (SteadyTime::max() != mNextIdleCheck ? coarseSteadyNow() : SteadyTime());   // clock only read while idle timeouts are in use
+
 #ifndef _WIN32
           if (result <= 0) goto completed;
 
@@ -1211,11 +1985,30 @@ namespace zsLib
             ZS_LOG_INSANE(log("socket event found") + ZS_PARAM("handle", record.fd) + ZS_PARAM("events", friendly(record.revents)))
 
 #ifndef _WIN32
-            if (record.fd == mWakeUpSocket->getSocket()) {
+            if ((-1 != mWakeUpReadFD) &&
+                (record.fd == mWakeUpReadFD)) {
+              if ((record.revents & (POLLIN | POLLRDNORM)) != 0) {
+                ZS_LOG_INSANE(log("read wake-up descriptor"))
+                if (!readWakeUpFD()) {
+                  redoWakeupSocket = true;
+                }
+              }
+
+              if ((record.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+                ZS_LOG_WARNING(Insane, log("wake up descriptor notified of a failure") + ZS_PARAM("revents", record.revents))
+                redoWakeupSocket = true;
+              }
+              continue;
+            }
+
+            if ((mWakeUpSocket) &&
+                (record.fd == mWakeUpSocket->getSocket())) {
               // related to wakeup socket
               if ((record.revents & POLLRDNORM) != 0) {
                 ZS_LOG_INSANE(log("read wake-up socket"))
 
+                mWakeUpPending = false;
+
                 bool wouldBlock = false;
                 static char gBogus[65536] {};
                 static BYTE *bogus = (BYTE *)&gBogus;
@@ -1246,33 +2039,59 @@ namespace zsLib
               continue;
             }
 
-            SocketPtr socket = (*found).second.lock();
+            if ((*found).second.mGeneration > mAppliedGeneration) {
+              // registered after the wait began thus the event belongs to a
+              // previous owner of the same handle
+              ZS_LOG_TRACE(log("event fired for pending registration thus ignoring") + ZS_PARAM("handle", record.fd) + ZS_PARAM("events", friendly(record.revents)))
+              continue;
+            }
+
+            SocketPtr socket = (*found).second.mSocket.lock();
             if (!socket) {
               // socket object is now gone and should no longer be monitored
               ZS_LOG_WARNING(Insane, log("event fired but socket is now gone thus removing") + ZS_PARAM("handle", record.fd) + ZS_PARAM("events", friendly(record.revents)))
 
               mSocketSet.reset(record.fd);
+              mSocketSet.setEdgeTriggered(record.fd, false);
               mMonitoredSockets.erase(found);
               continue;
             }
 
             ZS_LOG_INSANE(log("event fired") + ZS_PARAM("handle", record.fd) + ZS_PARAM("events", friendly(record.revents)))
 
+            bool zeroCopyCompletionsOnly = false;
+            if (((record.revents & POLLERR) != 0) &&
+                ((record.revents & (POLLHUP | POLLNVAL)) == 0)) {
+              // zero copy send completions are signalled as an error
+              zeroCopyCompletionsOnly = socket->readZeroCopyCompletions(record.fd);
+            }
+
             mSocketSet.firedEvent(socket, record.revents);
+            ++mTotalEvents;
+
+            if (Milliseconds() != (*found).second.mIdleTimeout) {
+              (*found).second.mLastActivity = activityTime;
+            }
 
             // check to see if should no longer be monitored
 
-            if ((record.revents & POLLRDNORM) != 0) {
+            bool keepArmed = (((*found).second.mEdgeTriggered) && (mSocketSet.supportsEdgeTriggered()));
+
+            if (((record.revents & POLLRDNORM) != 0) &&
+                (!keepArmed)) {
               mSocketSet.removeEvents(socket->getSocket(), POLLRDNORM);
             }
-            if ((record.revents & POLLWRNORM) != 0) {
+            if (((record.revents & POLLWRNORM) != 0) &&
+                (!keepArmed)) {
               mSocketSet.removeEvents(socket->getSocket(), POLLWRNORM);
             }
-            if ((record.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+            if (((record.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) &&
+                (!zeroCopyCompletionsOnly)) {
               ZS_LOG_WARNING(Insane, log("socket has exception thus removing monitor") + ZS_PARAM("handle", record.fd) + ZS_PARAM("events", friendly(record.revents)))
 
               // socket had a problem, do not monitor
               mSocketSet.reset(record.fd);
+              mSocketSet.setEdgeTriggered(record.fd, false);
               mMonitoredSockets.erase(found);
               continue;
             }
@@ -1281,10 +2100,23 @@ namespace zsLib
 
       completed:
 
+        // scope: lazily find sockets that have been idle too long
+        {
+          AutoRecursiveLock lock(mLock);
+          checkIdleTimeouts();
+        }
+
         // scope: fire notifications outside of the lock
         {
           poll_size totalFired = 0;
           FiredEventPair *fired = mSocketSet.getFiredEvents(totalFired);
+
+          if (totalFired > 0) {
+            if (mBusyPoll) mLastBusyPollActivity = steadyNow();
+            ++mTotalActiveWaits;
+            if (static_cast<size_t>(totalFired) > mMaxEventsPerWait) mMaxEventsPerWait = static_cast<size_t>(totalFired);  // only written by the monitor thread
+          }
+
           for (poll_size index = 0; index < totalFired; ++index)
           {
             FiredEventPair &record = fired[index];
@@ -1308,6 +2140,22 @@ namespace zsLib
               mShouldShutdown = true;
             }
           }
+
+          for (auto iter = mIdleSockets.begin(); iter != mIdleSockets.end(); ++iter)
+          {
+            SocketPtr &socket = (*iter);
+
+            try {
+              socket->notifyIdleTimeout();
+            } catch (ISocketDelegateProxy::Exceptions::DelegateGone &) {
+              ZS_LOG_WARNING(Trace, log("delegate gone") + ZS_PARAM("handle", socket->getSocket()))
+              mSocketSet.delegateGone(socket);
+            } catch (IMessageQueue::Exceptions::MessageQueueGone &) {
+              ZS_LOG_FATAL(Basic, log("message queue gone"))
+              mShouldShutdown = true;
+            }
+          }
+          mIdleSockets.clear();
         }
 
         // scope: clean out sockets with delegates gone
@@ -1323,6 +2171,7 @@ namespace zsLib
             ZS_LOG_WARNING(Trace, log("removing socket because delegate is gone") + ZS_PARAM("handle", socket->getSocket()))
 
             mSocketSet.reset(socket->getSocket());
+            mSocketSet.setEdgeTriggered(socket->getSocket(), false);
 
             SocketMap::iterator found = mMonitoredSockets.find(socket->getSocket());
             if (found != mMonitoredSockets.end()) {
@@ -1343,7 +2192,18 @@ namespace zsLib
 
       } while (!mShouldShutdown);
 
-      ZS_LOG_DETAIL(log("socket thread is shutting down"))
+      ZS_EVENTING_8(
+                    x, i, Debug, SocketMonitorStatistics, zs, Socket, Info,
+                    puid, monitor, mID,
+                    size_t, waits, mTotalWaits,
+                    size_t, activeWaits, mTotalActiveWaits,
+                    size_t, events, mTotalEvents,
+                    size_t, maxEventsPerWait, mMaxEventsPerWait,
+                    size_t, rebuilds, mSocketSet.getTotalRebuilds(),
+                    size_t, spinWaits, mTotalSpinWaits,
+                    size_t, wakeUps, mTotalWakeUps
+                    );
+      ZS_LOG_DETAIL(log("socket thread is shutting down") + ZS_PARAM("waits", mTotalWaits) + ZS_PARAM("active waits", mTotalActiveWaits) + ZS_PARAM("events", mTotalEvents) + ZS_PARAM("max events per wait", mMaxEventsPerWait) + ZS_PARAM("rebuilds", mSocketSet.getTotalRebuilds()) + ZS_PARAM("spin waits", mTotalSpinWaits) + ZS_PARAM("wake ups", mTotalWakeUps))
 
       SocketMonitorPtr gracefulReference;
 
@@ -1356,6 +2216,7 @@ namespace zsLib
 
         processWaiting();
         mMonitoredSockets.clear();
+        mPendingRegistrations.clear();
         mWaitingForRebuildList.clear();
         mSocketSet.clear();
         cleanWakeUpSocket();
@@ -1407,35 +2268,179 @@ namespace zsLib
       mWaitingForRebuildList.clear();
     }
 
+    //-------------------------------------------------------------------------
+    void SocketMonitor::applyRegistrations()
+    {
+      if (mPendingRegistrations.size() < 1) return;
+
+      ZS_LOG_INSANE(log("applying registrations") + ZS_PARAM("total", mPendingRegistrations.size()))
+
+      for (auto iter = mPendingRegistrations.begin(); iter != mPendingRegistrations.end(); ++iter)
+      {
+        SOCKET socketHandle = (*iter);
+
+        auto found = mMonitoredSockets.find(socketHandle);
+        if (found == mMonitoredSockets.end()) continue;                                 // cancelled before being applied
+
+        auto &monitored = (*found).second;
+        if (!monitored.mRegistrationQueued) continue;                                   // already applied (handle was registered twice)
+
+        mSocketSet.setEdgeTriggered(socketHandle, monitored.mEdgeTriggered);
+        mSocketSet.reset(socketHandle, monitored.mPendingEvents);
+        monitored.mPendingEvents = 0;
+        monitored.mRegistrationQueued = false;
+      }
+
+      mPendingRegistrations.clear();
+      mAppliedGeneration = mRegistrationGeneration;
+    }
+
+    //-------------------------------------------------------------------------
+    int SocketMonitor::getWaitTimeout() const
+    {
+      if (shouldSpin()) return 0;
+      if (SteadyTime::max() == mNextIdleCheck) return ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS;
+
+      SteadyTime now = coarseSteadyNow();
+      if (mNextIdleCheck <= now) return 0;
+
+      auto remaining = std::chrono::duration_cast<Milliseconds>(mNextIdleCheck - now) + Milliseconds(1);   // round up so the check is never early
+      if (remaining.count() > ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS) return ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS;
+      return static_cast<int>(remaining.count());
+    }
+
+    //-------------------------------------------------------------------------
+    bool SocketMonitor::shouldSpin() const
+    {
+      if (!mBusyPoll) return false;
+
+      Microseconds spinTimeout(mBusyPollSpinTimeout);
+      if (Microseconds() == spinTimeout) return true;
+
+      return (steadyNow() - mLastBusyPollActivity) < spinTimeout;                 // the coarse clock is too coarse for spin timeouts
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketMonitor::pinBusyPollThread()
+    {
+      int cpu = mBusyPollCPU;
+      if (cpu < 0) return;
+
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu, &cpus);
+      int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      if (0 != result) {
+        ZS_LOG_WARNING(Detail, log("failed to pin busy poll thread") + ZS_PARAM("cpu", cpu) + ZS_PARAM("error", result))
+        return;
+      }
+#elif defined(_WIN32)
+      if (0 == SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu)) {
+        ZS_LOG_WARNING(Detail, log("failed to pin busy poll thread") + ZS_PARAM("cpu", cpu) + ZS_PARAM("error", GetLastError()))
+        return;
+      }
+#else
+      ZS_LOG_WARNING(Detail, log("pinning threads is not supported") + ZS_PARAM("cpu", cpu))
+      return;
+#endif //HAVE_PTHREAD_SETAFFINITY_NP
+
+      ZS_LOG_DETAIL(log("busy poll thread pinned") + ZS_PARAM("cpu", cpu))
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketMonitor::checkIdleTimeouts()
+    {
+      if (SteadyTime::max() == mNextIdleCheck) return;
+
+      SteadyTime now = coarseSteadyNow();
+      if (now < mNextIdleCheck) return;
+
+      SteadyTime nextCheck = SteadyTime::max();
+      Milliseconds smallestTimeout = Milliseconds::max();
+
+      for (auto iter = mMonitoredSockets.begin(); iter != mMonitoredSockets.end(); ++iter)
+      {
+        auto &monitored = (*iter).second;
+        if (Milliseconds() == monitored.mIdleTimeout) continue;
+
+        SteadyTime deadline = monitored.mLastActivity + monitored.mIdleTimeout;
+        if (deadline <= now) {
+          SocketPtr socket = monitored.mSocket.lock();
+          if (socket) {
+            ZS_LOG_TRACE(log("socket idle timeout") + ZS_PARAM("handle", (*iter).first) + ZS_PARAM("timeout", monitored.mIdleTimeout))
+            mIdleSockets.push_back(socket);
+          }
+          monitored.mLastActivity = now;                                                // notify again only after another idle period
+          deadline = now + monitored.mIdleTimeout;
+        }
+
+        if (deadline < nextCheck) nextCheck = deadline;
+        if (monitored.mIdleTimeout < smallestTimeout) smallestTimeout = monitored.mIdleTimeout;
+      }
+
+      if (SteadyTime::max() != nextCheck) {
+        // every check visits all monitored sockets thus checks are spaced
+        // apart rather than following each individual deadline
+        Milliseconds interval = smallestTimeout / ZSLIB_SOCKET_MONITOR_IDLE_CHECK_DIVISOR;
+        if (interval < Milliseconds(ZSLIB_SOCKET_MONITOR_IDLE_CHECK_MIN_INTERVAL_IN_MILLISECONDS)) interval = Milliseconds(ZSLIB_SOCKET_MONITOR_IDLE_CHECK_MIN_INTERVAL_IN_MILLISECONDS);
+        if (nextCheck < now + interval) nextCheck = now + interval;
+      }
+
+      mNextIdleCheck = nextCheck;
+    }
+
     //-------------------------------------------------------------------------
     void SocketMonitor::wakeUp()
     {
 #ifdef _WIN32
       if (NULL == mWakeupEvent) return;
+      ++mTotalWakeUps;
       ::SetEvent(mWakeupEvent);
 #else
+      if (mWakeUpPending.exchange(true)) return;                                    // the monitor has not yet consumed the previous wake-up
+
+      ++mTotalWakeUps;
+
       int errorCode = 0;
 
       {
         AutoRecursiveLock lock(mLock);
 
-        if (!mWakeUpSocket)               // is the wakeup socket created?
-          return;
+        if (-1 != mWakeUpWriteFD) {
+#ifdef HAVE_EVENTFD
+          uint64_t value = 1;
+#else
+          BYTE value = 0;
+#endif //HAVE_EVENTFD
+          auto result = write(mWakeUpWriteFD, &value, sizeof(value));
+          if ((-1 == result) &&
+              (EAGAIN != errno)) {                                                     // a full pipe is already readable
+            errorCode = errno;
+          }
+        } else {
+          if (!mWakeUpSocket) {             // is the wakeup socket created?
+            mWakeUpPending = false;
+            return;
+          }
 
-        if (!mWakeUpSocket->isValid())
-        {
-          ZS_LOG_ERROR(Basic, "Could not wake up socket monitor as wakeup socket was closed. This will cause a delay in the socket monitor response time.")
-          return;
-        }
+          if (!mWakeUpSocket->isValid())
+          {
+            mWakeUpPending = false;
+            ZS_LOG_ERROR(Basic, "Could not wake up socket monitor as wakeup socket was closed. This will cause a delay in the socket monitor response time.")
+            return;
+          }
 
-        static DWORD gBogus = 0;
-        static BYTE *bogus = (BYTE *)&gBogus;
+          static DWORD gBogus = 0;
+          static BYTE *bogus = (BYTE *)&gBogus;
 
-        bool wouldBlock = false;
-        mWakeUpSocket->send(bogus, sizeof(gBogus), &wouldBlock, 0, &errorCode);       // send a bogus packet to its own port to wake it up
+          bool wouldBlock = false;
+          mWakeUpSocket->send(bogus, sizeof(gBogus), &wouldBlock, 0, &errorCode);     // send a bogus packet to its own port to wake it up
+        }
       }
 
       if (0 != errorCode) {
+        mWakeUpPending = false;
         ZS_LOG_ERROR(Basic, log("Could not wake up socket monitor. This will cause a delay in the socket monitor response time") + ZS_PARAM("error", errorCode))
       }
 #endif //_WIN32
@@ -1453,6 +2458,8 @@ namespace zsLib
 #else // _WIN32
       // WARNING: NEVER CALL THIS FROM WITHIN A LOCK
 
+      if (createWakeUpFD()) return;
+
       // ignore SIGPIPE
       int tries = 0;
       bool useIPv6 = true;
@@ -1533,10 +2540,91 @@ namespace zsLib
         mWakeupEvent = NULL;
       }
 #else // _WIN32
+      cleanWakeUpFD();
       mWakeUpSocket.reset();
 #endif // _WIN32
     }
 
+#ifndef _WIN32
+    //-------------------------------------------------------------------------
+    bool SocketMonitor::createWakeUpFD()
+    {
+      AutoRecursiveLock lock(mLock);
+
+      if (-1 != mWakeUpReadFD) {
+        mSocketSet.reset(mWakeUpReadFD);
+      }
+      cleanWakeUpFD();
+
+#ifdef HAVE_EVENTFD
+      if (!ISettings::getBool(ZSLIB_SETTING_SOCKET_MONITOR_DISABLE_EVENTFD)) {
+        mWakeUpReadFD = mWakeUpWriteFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (-1 == mWakeUpReadFD) {
+          ZS_LOG_WARNING(Detail, log("unable to create wake-up eventfd") + ZS_PARAM("error", errno))
+        }
+      }
+#endif //HAVE_EVENTFD
+
+      if (-1 == mWakeUpReadFD) {
+        int fds[2] {-1, -1};
+        if (0 != pipe(fds)) {
+          ZS_LOG_WARNING(Detail, log("unable to create wake-up pipe") + ZS_PARAM("error", errno))
+          return false;
+        }
+        for (size_t index = 0; index < 2; ++index) {
+          fcntl(fds[index], F_SETFL, fcntl(fds[index], F_GETFL) | O_NONBLOCK);
+          fcntl(fds[index], F_SETFD, FD_CLOEXEC);
+        }
+        mWakeUpReadFD = fds[0];
+        mWakeUpWriteFD = fds[1];
+      }
+
+      mWakeUpPending = false;
+      mWakeUpSocket.reset();
+
+      mSocketSet.reset(mWakeUpReadFD, POLLIN | POLLRDNORM | POLLERR | POLLHUP | POLLNVAL);   // an eventfd only reports POLLIN
+
+      ZS_LOG_DETAIL(log("created wake-up descriptor") + ZS_PARAM("read", mWakeUpReadFD) + ZS_PARAM("write", mWakeUpWriteFD))
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    bool SocketMonitor::readWakeUpFD()
+    {
+      mWakeUpPending = false;   // clear before draining so a racing wake-up is never lost
+
+      BYTE buffer[64];
+      while (true) {
+        auto result = read(mWakeUpReadFD, buffer, sizeof(buffer));
+        if (result > 0) continue;
+        if (0 == result) return false;
+
+        if (EINTR == errno) continue;
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) return true;
+
+        ZS_LOG_WARNING(Detail, log("wake up descriptor failed to read") + ZS_PARAM("error", errno))
+        return false;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketMonitor::cleanWakeUpFD()
+    {
+      AutoRecursiveLock lock(mLock);
+
+      if (-1 != mWakeUpWriteFD) {
+        if (mWakeUpWriteFD != mWakeUpReadFD) {
+          close(mWakeUpWriteFD);
+        }
+        mWakeUpWriteFD = -1;
+      }
+      if (-1 != mWakeUpReadFD) {
+        close(mWakeUpReadFD);
+        mWakeUpReadFD = -1;
+      }
+    }
+#endif //ndef _WIN32
+
     //-----------------------------------------------------------------------
     zsLib::Log::Params SocketMonitor::log(const char *message) const
     {
@@ -1559,5 +2647,907 @@ namespace zsLib
       return zsLib::Log::Params(message, "SocketMonitor");
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SocketCompletionEngine
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    SocketCompletionEngine::SocketCompletionEngine(
+                                                   const make_private &,
+                                                   bool useIOUring
+                                                   ) :
+      mUseIOUring(useIOUring)
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    SocketCompletionEngine::~SocketCompletionEngine()
+    {
+      mThisWeak.reset();
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    SocketCompletionEnginePtr SocketCompletionEngine::create(bool useIOUring)
+    {
+      auto pThis(make_shared<SocketCompletionEngine>(make_private{}, useIOUring));
+      pThis->mThisWeak = pThis;
+      pThis->init();
+      return pThis;
+    }
+
+    //-------------------------------------------------------------------------
+    SocketCompletionEnginePtr SocketCompletionEngine::singleton(bool useIOUring)
+    {
+      SocketCompletionEnginePtr result;
+
+      if (useIOUring) {
+        static SingletonLazySharedPtr<SocketCompletionEngine> singleton(create(true));
+        result = singleton.singleton();
+        static zsLib::SingletonManager::Register registerSingleton("org.zsLib.SocketCompletionEngine.io_uring", result);
+      } else {
+        static SingletonLazySharedPtr<SocketCompletionEngine> singleton(create(false));
+        result = singleton.singleton();
+        static zsLib::SingletonManager::Register registerSingleton("org.zsLib.SocketCompletionEngine.readiness", result);
+      }
+
+      if (!result) {
+        ZS_LOG_WARNING(Detail, slog("singleton gone"))
+      }
+
+      return result;
+    }
+
+    //-------------------------------------------------------------------------
+    SocketCompletionEnginePtr SocketCompletionEngine::link()
+    {
+      String engine = ISettings::getString(ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE);
+      return singleton("io_uring" == engine);
+    }
+
+    //-------------------------------------------------------------------------
+    const char *SocketCompletionEngine::getEngineName() const
+    {
+      return mUsingIOUring ? "io_uring" : "readiness";
+    }
+
+    //-------------------------------------------------------------------------
+    PUID SocketCompletionEngine::submit(Operation &operation)
+    {
+      operation.mID = zsLib::createPUID();
+      operation.mSubmitted = false;
+      operation.mPollFirst = false;
+      operation.mAddressLength = sizeof(operation.mAddress);
+
+      {
+        AutoRecursiveLock lock(mLock);
+
+        if (!mShouldShutdown) {
+          ZS_LOG_TRACE(log("submit") + ZS_PARAM("operation", operation.mID) + ZS_PARAM("type", static_cast<int>(operation.mType)) + ZS_PARAM("handle", operation.mHandle))
+
+          mOperations[operation.mID] = operation;
+#ifdef HAVE_IO_URING
+          if (mUsingIOUring) mPendingSubmissions.push_back(operation.mID);
+#endif //HAVE_IO_URING
+          wakeUp();
+          return operation.mID;
+        }
+      }
+
+      ZS_LOG_WARNING(Detail, log("cannot submit as engine is shutting down") + ZS_PARAM("operation", operation.mID))
+
+      CompletionList completions;
+      Completion completion;
+      completion.mOperation = operation;
+      completion.mError = ECANCELED;
+      completions.push_back(completion);
+      deliver(completions);
+      return operation.mID;
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::cancel(SOCKET handle)
+    {
+      CompletionList completions;
+
+      {
+        AutoRecursiveLock lock(mLock);
+
+        bool cancelsPending = false;
+
+        for (auto iter_doNotUse = mOperations.begin(); iter_doNotUse != mOperations.end(); )
+        {
+          auto current = iter_doNotUse;
+          ++iter_doNotUse;
+
+          auto &operation = (*current).second;
+          if (operation.mHandle != handle) continue;
+
+          if (operation.mSubmitted) {
+            // the kernel completes the operation with ECANCELED
+            mPendingCancels.push_back(operation.mID);
+            cancelsPending = true;
+            continue;
+          }
+
+          Completion completion;
+          completion.mOperation = operation;
+          completion.mError = ECANCELED;
+          completions.push_back(completion);
+
+          mOperations.erase(current);
+        }
+
+        if (completions.size() > 0) {
+          ZS_LOG_TRACE(log("cancelled operations") + ZS_PARAM("handle", handle) + ZS_PARAM("total", completions.size()))
+        }
+
+        if ((cancelsPending) || (completions.size() > 0)) wakeUp();    // the readiness loop must stop polling the handle
+      }
+
+      deliver(completions);
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::operator()()
+    {
+      // the thread keeps the engine alive until it exits so the engine can
+      // never be destroyed while this method is still running on it (declared
+      // first so it is the last object released)
+      SocketCompletionEnginePtr pThis = mThisWeak.lock();
+
+      debugSetCurrentThreadName("org.zsLib.socketCompletionEngine");
+      zsLib::Socket::ignoreSIGPIPEOnThisThread();
+
+      ZS_LOG_DETAIL(log("socket completion engine thread started") + ZS_PARAM("engine", getEngineName()))
+
+      mThreadReady.notify();
+
+#ifdef HAVE_IO_URING
+      if (mUsingIOUring) {
+        runIOUring();
+      } else
+#endif //HAVE_IO_URING
+      {
+        runReadiness();
+      }
+
+      ZS_LOG_DETAIL(log("socket completion engine thread is shutting down"))
+
+      SocketCompletionEnginePtr gracefulReference;
+      CompletionList completions;
+
+      {
+        AutoRecursiveLock lock(mLock);
+
+        // transfer the reference to the thread
+        gracefulReference = mGracefulReference;
+        mGracefulReference.reset();
+
+        for (auto iter = mOperations.begin(); iter != mOperations.end(); ++iter)
+        {
+          Completion completion;
+          completion.mOperation = (*iter).second;
+          completion.mError = ECANCELED;
+          completions.push_back(completion);
+        }
+
+        mOperations.clear();
+        mPendingSubmissions.clear();
+        mPendingCancels.clear();
+      }
+
+      deliver(completions);
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::init()
+    {
+#ifdef HAVE_IO_URING
+      if (mUseIOUring) {
+        mUsingIOUring = setupIOUring();
+      }
+#endif //HAVE_IO_URING
+
+      if ((mUseIOUring) &&
+          (!mUsingIOUring)) {
+        ZS_LOG_WARNING(Basic, log("io_uring is not available thus falling back to readiness based completions"))
+      }
+
+      createWakeUp();
+
+      mThread = ThreadPtr(new std::thread(std::ref(*this)));
+      setThreadPriority(mThread->native_handle(), zsLib::threadPriorityFromString(ISettings::getString(ZSLIB_SETTING_SOCKET_MONITOR_THREAD_PRIORITY)));
+
+      mThreadReady.wait();
+    }
+
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SocketCompletionEngine => ISingletonManagerDelegate
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::notifySingletonCleanup()
+    {
+      cancel();
+    }
+
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SocketCompletionEngine => (internal)
+    #pragma mark
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::cancel()
+    {
+      ZS_LOG_DETAIL(log("cancel called"))
+
+      ThreadPtr thread;
+
+      {
+        AutoRecursiveLock lock(mLock);
+        mGracefulReference = mThisWeak.lock();
+        thread = mThread;
+        mThread.reset();
+
+        mShouldShutdown = true;
+        wakeUp();
+      }
+
+      if (thread) {
+        if (thread->get_id() == std::this_thread::get_id()) {
+          thread->detach();                                                           // cancelled from within a delivered completion
+        } else if (thread->joinable()) {
+          thread->join();
+        }
+      }
+
+      AutoRecursiveLock lock(mLock);
+      cleanWakeUp();
+#ifdef HAVE_IO_URING
+      cleanIOUring();
+#endif //HAVE_IO_URING
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::runReadiness()
+    {
+      std::vector<SocketSet::poll_fd> pollFDs;
+      std::vector<PUID> pollOperations;
+
+      while (!mShouldShutdown)
+      {
+        pollFDs.clear();
+        pollOperations.clear();
+
+        {
+          AutoRecursiveLock lock(mLock);
+
+          SocketSet::poll_fd wakeUpRecord {};
+          wakeUpRecord.fd = mWakeUpHandle;
+          wakeUpRecord.events = POLLIN;
+          pollFDs.push_back(wakeUpRecord);
+          pollOperations.push_back(0);
+
+          for (auto iter = mOperations.begin(); iter != mOperations.end(); ++iter)
+          {
+            auto &operation = (*iter).second;
+
+            SocketSet::poll_fd record {};
+            record.fd = operation.mHandle;
+            record.events = (OperationType_Send == operation.mType ? POLLOUT : POLLIN);
+            pollFDs.push_back(record);
+            pollOperations.push_back(operation.mID);
+          }
+        }
+
+#ifdef _WIN32
+        int result = WSAPoll(&(pollFDs[0]), static_cast<ULONG>(pollFDs.size()), ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS);
+#else
+        int result = ::poll(&(pollFDs[0]), static_cast<SocketSet::poll_size>(pollFDs.size()), ZSLIB_SOCKET_MONITOR_TIMEOUT_IN_MILLISECONDS);
+#endif //_WIN32
+
+        if (result < 0) {
+#ifndef _WIN32
+          if (EINTR == errno) continue;
+#endif //ndef _WIN32
+          ZS_LOG_WARNING(Detail, log("poll failed") + ZS_PARAM("error", errno))
+          std::this_thread::yield();                                                  // do not hammer CPU
+          continue;
+        }
+        if (0 == result) continue;
+
+        CompletionList completions;
+
+        {
+          AutoRecursiveLock lock(mLock);
+
+          if (0 != pollFDs[0].revents) readWakeUp();
+
+          for (size_t index = 1; index < pollFDs.size(); ++index)
+          {
+            if (0 == pollFDs[index].revents) continue;
+
+            auto found = mOperations.find(pollOperations[index]);
+            if (found == mOperations.end()) continue;                                 // cancelled while polling
+
+            Completion completion;
+            if (!perform((*found).second, completion)) continue;                      // would block thus poll again
+
+            completions.push_back(completion);
+            mOperations.erase(found);
+          }
+        }
+
+        deliver(completions);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    bool SocketCompletionEngine::perform(
+                                         Operation &operation,
+                                         Completion &outCompletion
+                                         )
+    {
+      int flags = static_cast<int>(operation.mFlags);
+#ifdef MSG_DONTWAIT
+      flags |= MSG_DONTWAIT;
+#endif //MSG_DONTWAIT
+
+      ssize_t result = SOCKET_ERROR;
+
+      switch (operation.mType)
+      {
+        case OperationType_Receive: {
+          result = ::recv(operation.mHandle, (char *)operation.mBuffer, SafeInt<int>(operation.mBufferLengthInBytes), flags);
+          break;
+        }
+        case OperationType_Send: {
+#ifdef MSG_NOSIGNAL
+          flags |= MSG_NOSIGNAL;
+#endif //MSG_NOSIGNAL
+          result = ::send(operation.mHandle, (const char *)operation.mBuffer, SafeInt<int>(operation.mBufferLengthInBytes), flags);
+          break;
+        }
+        case OperationType_Accept: {
+          operation.mAddressLength = sizeof(operation.mAddress);
+          SOCKET accepted = ::accept(operation.mHandle, (sockaddr *)&(operation.mAddress), &(operation.mAddressLength));
+          if (INVALID_SOCKET != accepted) result = static_cast<ssize_t>(accepted);
+          break;
+        }
+      }
+
+      outCompletion.mOperation = operation;
+
+      if (SOCKET_ERROR == result) {
+#ifdef _WIN32
+        int error = WSAGetLastError();
+#else
+        int error = errno;
+#endif //_WIN32
+        if ((WSAEWOULDBLOCK == error) ||
+            (EAGAIN == error) ||
+            (EINTR == error)) {
+          return false;
+        }
+        outCompletion.mError = error;
+        return true;
+      }
+
+      outCompletion.mResult = result;
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::deliver(CompletionList &completions)
+    {
+      for (auto iter = completions.begin(); iter != completions.end(); ++iter)
+      {
+        auto &completion = (*iter);
+        auto &operation = completion.mOperation;
+
+        size_t bytes = (completion.mResult > 0 ? static_cast<size_t>(completion.mResult) : 0);
+
+        SocketPtr acceptedSocket;
+        IPAddress remoteIP;
+
+        if ((OperationType_Accept == operation.mType) &&
+            (0 == completion.mError)) {
+          acceptedSocket = zsLib::Socket::create();
+          acceptedSocket->adopt(static_cast<SOCKET>(completion.mResult));
+          remoteIP = toIPAddress(operation.mAddress, operation.mAddressLength);
+        }
+
+        ZS_LOG_TRACE(log("completed") + ZS_PARAM("operation", operation.mID) + ZS_PARAM("type", static_cast<int>(operation.mType)) + ZS_PARAM("bytes", bytes) + ZS_PARAM("error", completion.mError))
+
+        if (!operation.mDelegate) continue;
+
+        SocketPtr socket = operation.mSocket.lock();
+
+        try {
+          switch (operation.mType)
+          {
+            case OperationType_Receive: operation.mDelegate->onSocketReceiveCompleted(socket, operation.mID, operation.mBuffer, bytes, completion.mError); break;
+            case OperationType_Send:    operation.mDelegate->onSocketSendCompleted(socket, operation.mID, operation.mBuffer, bytes, completion.mError); break;
+            case OperationType_Accept:  operation.mDelegate->onSocketAcceptCompleted(socket, operation.mID, acceptedSocket, remoteIP, completion.mError); break;
+          }
+        } catch (ISocketCompletionDelegateProxy::Exceptions::DelegateGone &) {
+          ZS_LOG_WARNING(Detail, log("completion delegate gone") + ZS_PARAM("operation", operation.mID))
+        }
+      }
+
+      completions.clear();
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::wakeUp()
+    {
+      if (mWakeUpPending.exchange(true)) return;                                    // the engine has not yet consumed the previous wake-up
+
+      int errorCode = 0;
+
+      {
+        AutoRecursiveLock lock(mLock);
+
+        if (mWakeUpSocket) {
+          static DWORD gBogus = 0;
+          static BYTE *bogus = (BYTE *)&gBogus;
+
+          bool wouldBlock = false;
+          mWakeUpSocket->send(bogus, sizeof(gBogus), &wouldBlock, 0, &errorCode);     // send a bogus packet to its own port to wake it up
+#ifdef HAVE_EVENTFD
+        } else if (INVALID_SOCKET != mWakeUpHandle) {
+          uint64_t value = 1;
+          auto result = write(mWakeUpHandle, &value, sizeof(value));
+          if ((-1 == result) &&
+              (EAGAIN != errno)) {
+            errorCode = errno;
+          }
+#endif //HAVE_EVENTFD
+        } else {
+          mWakeUpPending = false;
+          return;
+        }
+      }
+
+      if (0 != errorCode) {
+        mWakeUpPending = false;
+        ZS_LOG_ERROR(Basic, log("could not wake up socket completion engine") + ZS_PARAM("error", errorCode))
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::createWakeUp()
+    {
+      AutoRecursiveLock lock(mLock);
+
+#ifdef HAVE_EVENTFD
+      mWakeUpHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (INVALID_SOCKET != mWakeUpHandle) {
+        ZS_LOG_DETAIL(log("created wake-up eventfd") + ZS_PARAM("handle", mWakeUpHandle))
+        return;
+      }
+      ZS_LOG_WARNING(Detail, log("unable to create wake-up eventfd") + ZS_PARAM("error", errno))
+#endif //HAVE_EVENTFD
+
+      try {
+        mWakeUpSocket = zsLib::Socket::createUDP(zsLib::Socket::Create::IPv4);
+        mWakeUpSocket->unlinkSocketMonitor();                                         // never monitored by a socket monitor
+
+        IPAddress address(IPAddress::loopbackV4());
+        address.setPort(0);
+
+        mWakeUpSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+        mWakeUpSocket->bind(address);
+        mWakeUpSocket->connect(mWakeUpSocket->getLocalAddress());
+
+        mWakeUpHandle = mWakeUpSocket->getSocket();
+        ZS_LOG_DETAIL(log("created wake-up socket") + ZS_PARAM("handle", mWakeUpHandle))
+      } catch (zsLib::Socket::Exceptions::Unspecified &) {
+        ZS_LOG_ERROR(Basic, log("unable to create wake-up socket"))
+        mWakeUpSocket.reset();
+        mWakeUpHandle = INVALID_SOCKET;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::readWakeUp()
+    {
+      mWakeUpPending = false;   // clear before draining so a racing wake-up is never lost
+
+      if (mWakeUpSocket) {
+        BYTE buffer[64];
+        while (true) {
+          bool wouldBlock = false;
+          int errorCode = 0;
+          size_t received = mWakeUpSocket->receive(buffer, sizeof(buffer), &wouldBlock, 0, &errorCode);
+          if ((wouldBlock) || (0 != errorCode) || (0 == received)) return;
+        }
+      }
+
+#ifdef HAVE_EVENTFD
+      uint64_t value = 0;
+      while (true) {
+        auto result = read(mWakeUpHandle, &value, sizeof(value));
+        if (result > 0) continue;
+        if ((-1 == result) && (EINTR == errno)) continue;
+        return;
+      }
+#endif //HAVE_EVENTFD
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::cleanWakeUp()
+    {
+      if (mWakeUpSocket) {
+        mWakeUpSocket.reset();
+        mWakeUpHandle = INVALID_SOCKET;
+        return;
+      }
+
+#ifdef HAVE_EVENTFD
+      if (INVALID_SOCKET != mWakeUpHandle) {
+        close(mWakeUpHandle);
+        mWakeUpHandle = INVALID_SOCKET;
+      }
+#endif //HAVE_EVENTFD
+    }
+
+#ifdef HAVE_IO_URING
+    //-------------------------------------------------------------------------
+    bool SocketCompletionEngine::setupIOUring()
+    {
+      unsigned depth = SafeInt<unsigned>(ISettings::getUInt(ZSLIB_SETTING_SOCKET_COMPLETION_QUEUE_DEPTH));
+      if (0 == depth) depth = ZSLIB_SOCKET_COMPLETION_DEFAULT_QUEUE_DEPTH;
+
+      io_uring_params params;
+      memset(&params, 0, sizeof(params));
+
+      mRingFD = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+      if (mRingFD < 0) {
+        ZS_LOG_WARNING(Detail, log("unable to create io_uring") + ZS_PARAM("error", errno))
+        mRingFD = -1;
+        return false;
+      }
+
+      if ((0 == (params.features & IORING_FEAT_NODROP)) ||
+          (0 == (params.features & IORING_FEAT_FAST_POLL))) {
+        // without internal polling socket operations would block a kernel worker each
+        ZS_LOG_WARNING(Detail, log("io_uring does not support socket completions") + ZS_PARAM("features", params.features))
+        cleanIOUring();
+        return false;
+      }
+
+      mSubmissionRingSize = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+      mCompletionRingSize = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+
+      bool singleMap = (0 != (params.features & IORING_FEAT_SINGLE_MMAP));
+      if (singleMap) {
+        mSubmissionRingSize = mCompletionRingSize = (mSubmissionRingSize > mCompletionRingSize ? mSubmissionRingSize : mCompletionRingSize);
+      }
+
+      void *mapped = mmap(NULL, mSubmissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFD, IORING_OFF_SQ_RING);
+      if (MAP_FAILED == mapped) {
+        ZS_LOG_WARNING(Detail, log("unable to map io_uring submission ring") + ZS_PARAM("error", errno))
+        cleanIOUring();
+        return false;
+      }
+      mSubmissionRing = mapped;
+
+      if (singleMap) {
+        mCompletionRing = mSubmissionRing;
+      } else {
+        mapped = mmap(NULL, mCompletionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFD, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == mapped) {
+          ZS_LOG_WARNING(Detail, log("unable to map io_uring completion ring") + ZS_PARAM("error", errno))
+          cleanIOUring();
+          return false;
+        }
+        mCompletionRing = mapped;
+      }
+
+      mSubmissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+      mapped = mmap(NULL, mSubmissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFD, IORING_OFF_SQES);
+      if (MAP_FAILED == mapped) {
+        ZS_LOG_WARNING(Detail, log("unable to map io_uring submission entries") + ZS_PARAM("error", errno))
+        cleanIOUring();
+        return false;
+      }
+      mSubmissionEntries = (io_uring_sqe *)mapped;
+
+      BYTE *submissionRing = (BYTE *)mSubmissionRing;
+      mSubmissionHead = (unsigned *)(submissionRing + params.sq_off.head);
+      mSubmissionTail = (unsigned *)(submissionRing + params.sq_off.tail);
+      mSubmissionArray = (unsigned *)(submissionRing + params.sq_off.array);
+      mSubmissionMask = *((unsigned *)(submissionRing + params.sq_off.ring_mask));
+      mSubmissionTotal = *((unsigned *)(submissionRing + params.sq_off.ring_entries));
+      mSubmissionLocalTail = *mSubmissionTail;
+
+      BYTE *completionRing = (BYTE *)mCompletionRing;
+      mCompletionHead = (unsigned *)(completionRing + params.cq_off.head);
+      mCompletionTail = (unsigned *)(completionRing + params.cq_off.tail);
+      mCompletionMask = *((unsigned *)(completionRing + params.cq_off.ring_mask));
+      mCompletionEntries = (io_uring_cqe *)(completionRing + params.cq_off.cqes);
+
+      ZS_LOG_DETAIL(log("created io_uring") + ZS_PARAM("submission entries", params.sq_entries) + ZS_PARAM("completion entries", params.cq_entries) + ZS_PARAM("features", params.features))
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::cleanIOUring()
+    {
+      if (mSubmissionEntries) {
+        munmap(mSubmissionEntries, mSubmissionEntriesSize);
+        mSubmissionEntries = NULL;
+      }
+      if ((mCompletionRing) &&
+          (mCompletionRing != mSubmissionRing)) {
+        munmap(mCompletionRing, mCompletionRingSize);
+      }
+      mCompletionRing = NULL;
+      if (mSubmissionRing) {
+        munmap(mSubmissionRing, mSubmissionRingSize);
+        mSubmissionRing = NULL;
+      }
+      if (-1 != mRingFD) {
+        close(mRingFD);
+        mRingFD = -1;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::runIOUring()
+    {
+      while (!mShouldShutdown)
+      {
+        bool morePending = false;
+        unsigned toSubmit = 0;
+
+        {
+          AutoRecursiveLock lock(mLock);
+          stageSubmissions(morePending);
+          toSubmit = mSubmissionLocalTail - __atomic_load_n(mSubmissionHead, __ATOMIC_ACQUIRE);
+        }
+
+        // submit everything staged and wait for completions in a single call
+        unsigned waitFor = (morePending ? 0 : 1);
+        int result = static_cast<int>(syscall(__NR_io_uring_enter, mRingFD, toSubmit, waitFor, IORING_ENTER_GETEVENTS, NULL, 0));
+        if (result < 0) {
+          int error = errno;
+          if ((EINTR != error) &&
+              (EAGAIN != error) &&
+              (EBUSY != error)) {
+            ZS_LOG_ERROR(Detail, log("io_uring enter failed") + ZS_PARAM("error", error))
+            std::this_thread::yield();                                                // do not hammer CPU
+          }
+        }
+
+        CompletionList completions;
+
+        {
+          AutoRecursiveLock lock(mLock);
+          reapCompletions(completions);
+        }
+
+        deliver(completions);
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    io_uring_sqe *SocketCompletionEngine::nextSQE()
+    {
+      unsigned head = __atomic_load_n(mSubmissionHead, __ATOMIC_ACQUIRE);
+      if (mSubmissionLocalTail - head >= mSubmissionTotal) return NULL;               // ring is full until the kernel consumes
+
+      unsigned index = mSubmissionLocalTail & mSubmissionMask;
+      io_uring_sqe *entry = &(mSubmissionEntries[index]);
+      memset(entry, 0, sizeof(*entry));
+      mSubmissionArray[index] = index;
+      ++mSubmissionLocalTail;
+      return entry;
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::stageSubmissions(bool &outMorePending)
+    {
+      outMorePending = false;
+
+      if (!mWakeUpArmed) {
+        io_uring_sqe *entry = nextSQE();
+        if (entry) {
+          entry->opcode = IORING_OP_POLL_ADD;
+          entry->fd = mWakeUpHandle;
+          entry->poll_events = POLLIN;
+          entry->user_data = ZSLIB_SOCKET_COMPLETION_WAKE_UP_USER_DATA;
+          mWakeUpArmed = true;
+        } else {
+          outMorePending = true;
+        }
+      }
+
+      while (mPendingCancels.size() > 0)
+      {
+        PUID id = mPendingCancels.front();
+
+        // a retried operation also has a linked poll in flight
+        auto found = mOperations.find(id);
+        bool pollFirst = ((found != mOperations.end()) && ((*found).second.mPollFirst));
+
+        io_uring_sqe *entry = nextSQE();
+        io_uring_sqe *pollEntry = (pollFirst ? nextSQE() : NULL);
+        if ((!entry) ||
+            ((pollFirst) && (!pollEntry))) {
+          if (entry) --mSubmissionLocalTail;
+          outMorePending = true;
+          break;
+        }
+
+        mPendingCancels.pop_front();
+
+        entry->opcode = IORING_OP_ASYNC_CANCEL;
+        entry->fd = -1;
+        entry->addr = static_cast<__u64>(id);
+        entry->user_data = ZSLIB_SOCKET_COMPLETION_IGNORE_USER_DATA;
+
+        if (pollEntry) {
+          pollEntry->opcode = IORING_OP_ASYNC_CANCEL;
+          pollEntry->fd = -1;
+          pollEntry->addr = static_cast<__u64>(id) | ZSLIB_SOCKET_COMPLETION_POLL_USER_DATA_FLAG;
+          pollEntry->user_data = ZSLIB_SOCKET_COMPLETION_IGNORE_USER_DATA;
+        }
+      }
+
+      while (mPendingSubmissions.size() > 0)
+      {
+        PUID id = mPendingSubmissions.front();
+
+        auto found = mOperations.find(id);
+        if (found == mOperations.end()) {
+          mPendingSubmissions.pop_front();                                            // cancelled before being submitted
+          continue;
+        }
+
+        auto &operation = (*found).second;
+
+        io_uring_sqe *pollEntry = (operation.mPollFirst ? nextSQE() : NULL);
+        io_uring_sqe *entry = nextSQE();
+        if ((!entry) ||
+            ((operation.mPollFirst) && (!pollEntry))) {
+          if (entry) --mSubmissionLocalTail;
+          if (pollEntry) --mSubmissionLocalTail;
+          outMorePending = true;
+          break;
+        }
+
+        mPendingSubmissions.pop_front();
+
+        if (pollEntry) {
+          pollEntry->opcode = IORING_OP_POLL_ADD;
+          pollEntry->fd = operation.mHandle;
+          pollEntry->poll_events = (OperationType_Send == operation.mType ? POLLOUT : POLLIN);
+          pollEntry->flags = IOSQE_IO_LINK;
+          pollEntry->user_data = static_cast<__u64>(operation.mID) | ZSLIB_SOCKET_COMPLETION_POLL_USER_DATA_FLAG;
+        }
+
+        unsigned length = (operation.mBufferLengthInBytes > UINT_MAX ? UINT_MAX : static_cast<unsigned>(operation.mBufferLengthInBytes));
+
+        entry->fd = operation.mHandle;
+        entry->user_data = static_cast<__u64>(operation.mID);
+
+        switch (operation.mType)
+        {
+          case OperationType_Receive: {
+            entry->opcode = IORING_OP_RECV;
+            entry->addr = reinterpret_cast<__u64>(operation.mBuffer);
+            entry->len = length;
+            entry->msg_flags = static_cast<__u32>(operation.mFlags);
+            break;
+          }
+          case OperationType_Send: {
+            entry->opcode = IORING_OP_SEND;
+            entry->addr = reinterpret_cast<__u64>(operation.mBuffer);
+            entry->len = length;
+            entry->msg_flags = static_cast<__u32>(operation.mFlags) | MSG_NOSIGNAL;
+            break;
+          }
+          case OperationType_Accept: {
+            operation.mAddressLength = sizeof(operation.mAddress);
+            entry->opcode = IORING_OP_ACCEPT;
+            entry->addr = reinterpret_cast<__u64>(&(operation.mAddress));
+            entry->addr2 = reinterpret_cast<__u64>(&(operation.mAddressLength));
+            entry->accept_flags = SOCK_CLOEXEC;
+            break;
+          }
+        }
+
+        operation.mSubmitted = true;
+      }
+
+      __atomic_store_n(mSubmissionTail, mSubmissionLocalTail, __ATOMIC_RELEASE);
+    }
+
+    //-------------------------------------------------------------------------
+    void SocketCompletionEngine::reapCompletions(CompletionList &outCompletions)
+    {
+      unsigned head = *mCompletionHead;
+      unsigned tail = __atomic_load_n(mCompletionTail, __ATOMIC_ACQUIRE);
+
+      while (head != tail)
+      {
+        io_uring_cqe &entry = mCompletionEntries[head & mCompletionMask];
+        ++head;
+
+        if (ZSLIB_SOCKET_COMPLETION_WAKE_UP_USER_DATA == entry.user_data) {
+          mWakeUpArmed = false;
+          readWakeUp();
+          continue;
+        }
+        if (ZSLIB_SOCKET_COMPLETION_IGNORE_USER_DATA == entry.user_data) continue;
+        if (0 != (entry.user_data & ZSLIB_SOCKET_COMPLETION_POLL_USER_DATA_FLAG)) continue;   // linked poll fired, the operation follows
+
+        auto found = mOperations.find(static_cast<PUID>(entry.user_data));
+        if (found == mOperations.end()) continue;
+
+        auto &operation = (*found).second;
+
+        if ((-EAGAIN == entry.res) &&
+            (!operation.mPollFirst)) {
+          // older kernels do not poll non-blocking sockets internally thus
+          // retry with a poll linked ahead of the operation
+          operation.mSubmitted = false;
+          operation.mPollFirst = true;
+          mPendingSubmissions.push_back(operation.mID);
+          continue;
+        }
+
+        if (-EAGAIN == entry.res) {
+          operation.mSubmitted = false;                                               // readiness was spurious, poll again
+          mPendingSubmissions.push_back(operation.mID);
+          continue;
+        }
+
+        Completion completion;
+        completion.mOperation = operation;
+        if (entry.res < 0) {
+          completion.mError = -entry.res;
+        } else {
+          completion.mResult = entry.res;
+        }
+        outCompletions.push_back(completion);
+
+        mOperations.erase(found);
+      }
+
+      __atomic_store_n(mCompletionHead, head, __ATOMIC_RELEASE);
+    }
+#endif //HAVE_IO_URING
+
+    //-----------------------------------------------------------------------
+    zsLib::Log::Params SocketCompletionEngine::log(const char *message) const
+    {
+      ElementPtr objectEl = Element::create("SocketCompletionEngine");
+
+      ElementPtr element = Element::create("id");
+
+      TextPtr tmpTxt = Text::create();
+      tmpTxt->setValueAndJSONEncode(string(mID));
+      element->adoptAsFirstChild(tmpTxt);
+
+      objectEl->adoptAsLastChild(element);
+
+      return zsLib::Log::Params(message, objectEl);
+    }
+
+    //-----------------------------------------------------------------------
+    zsLib::Log::Params SocketCompletionEngine::slog(const char *message)
+    {
+      return zsLib::Log::Params(message, "SocketCompletionEngine");
+    }
+
   }
 }
@@ -56,7 +56,8 @@ namespace zsLib
                  ITimerDelegatePtr delegate,
                  Microseconds timeout,
                  bool repeat,
-                 size_t maxFiringsAtOnce
+                 size_t maxFiringsAtOnce,
+                 Microseconds tolerance
                  )
     {
       mDelegate = ITimerDelegateProxy::createWeak(delegate);
@@ -66,9 +67,10 @@ namespace zsLib
       mOnceOnly = !repeat;
       mMaxFiringsAtOnce = maxFiringsAtOnce;
       mTimeout = timeout;
+      mTolerance = (tolerance > Microseconds() ? tolerance : Microseconds());
       mID = createPUID();
       mMonitored = false;
-      mFireNextAt = (std::chrono::system_clock::now() + timeout);
+      mFireNextAt = (zsLib::steadyNow() + timeout);
 
       ZS_EVENTING_3(x, i, Trace, TimerCreate, zs, Timer, Start, puid, id, mID, bool, repeat, repeat, duration, timeoutInMicroseconds, timeout.count());
     }
@@ -86,15 +88,19 @@ namespace zsLib
                            ITimerDelegatePtr delegate,
                            Microseconds timeout,
                            bool repeat,
-                           size_t maxFiringTimerAtOnce
+                           size_t maxFiringTimerAtOnce,
+                           Microseconds tolerance
                            )
     {
-      TimerPtr timer(make_shared<Timer>(make_private{}, delegate, timeout, repeat, maxFiringTimerAtOnce));
+      TimerPtr timer(make_shared<Timer>(make_private{}, delegate, timeout, repeat, maxFiringTimerAtOnce, tolerance));
       timer->mThisWeak = timer;
 
-      internal::TimerMonitorPtr singleton = internal::TimerMonitor::singleton();
-      if (singleton) {
-        singleton->monitorBegin(timer);
+      // timers for the same queue share a monitor so their firings can be
+      // delivered together
+      internal::TimerMonitorPtr monitor = internal::TimerMonitor::monitorFor(ITimerDelegateProxy::getAssociatedMessageQueue(timer->mDelegate));
+      if (monitor) {
+        timer->mMonitor = monitor;
+        monitor->monitorBegin(timer);
       }
       timer->mMonitored = true;
       return timer;
@@ -103,15 +109,31 @@ namespace zsLib
     //---------------------------------------------------------------------------
     TimerPtr Timer::create(
                            ITimerDelegatePtr delegate,
-                           Time timeout
+                           Time timeout,
+                           Microseconds tolerance
                            )
     {
       Time now = zsLib::now();
       if (now > timeout) {
-        return create(delegate, Microseconds(0), false, 1);
+        return create(delegate, Microseconds(0), false, 1, tolerance);
       }
       Microseconds waitTime = std::chrono::duration_cast<Microseconds>(timeout - now);
-      return create(delegate, waitTime, false, 1);
+      return create(delegate, waitTime, false, 1, tolerance);
+    }
+
+    //---------------------------------------------------------------------------
+    TimerPtr Timer::create(
+                           ITimerDelegatePtr delegate,
+                           SteadyTime timeout,
+                           Microseconds tolerance
+                           )
+    {
+      SteadyTime now = zsLib::steadyNow();
+      if (now > timeout) {
+        return create(delegate, Microseconds(0), false, 1, tolerance);
+      }
+      Microseconds waitTime = std::chrono::duration_cast<Microseconds>(timeout - now);
+      return create(delegate, waitTime, false, 1, tolerance);
     }
 
     //---------------------------------------------------------------------------
@@ -124,9 +146,9 @@ namespace zsLib
           return;
       }
 
-      internal::TimerMonitorPtr singleton = internal::TimerMonitor::singleton();
-      if (singleton) {
-        singleton->monitorEnd(*this);
+      internal::TimerMonitorPtr monitor = mMonitor.lock();
+      if (monitor) {
+        monitor->monitorEnd(*this);
       }
 
       {
@@ -148,19 +170,38 @@ namespace zsLib
     }
 
     //-------------------------------------------------------------------------
-    bool Timer::tick(const Time &time, Microseconds &sleepTime)
+    bool Timer::tick(
+                     const SteadyTime &time,
+                     SteadyTime &outFireNextAt,
+                     IMessageQueuePtr &outQueue,
+                     ITimerDelegatePtr &outDelegate,
+                     size_t &outTotalFirings
+                     )
     {
       AutoRecursiveLock lock(mLock);
       bool fired = false;
       UINT totalFires = 0;
 
-      while (mFireNextAt < time)
+      outTotalFirings = 0;
+
+      while (mFireNextAt <= time)
       {
         fired = true;
         try {
           ZS_EVENTING_1(x, i, Insane, TimerEvent, zs, Timer, Event, puid, id, mID);
 
-          mDelegate->onTimer(mThisWeak.lock());
+          if (!outDelegate) {
+            // the firing is handed back to the timer monitor which delivers
+            // all firings destined to the same queue in a single message
+            outQueue = ITimerDelegateProxy::getAssociatedMessageQueue(mDelegate);
+            outDelegate = ITimerDelegateProxy::original(mDelegate, true);
+          }
+
+          if (outQueue) {
+            ++outTotalFirings;
+          } else {
+            mDelegate->onTimer(mThisWeak.lock());
+          }
         } catch (ITimerDelegateProxy::Exceptions::DelegateGone &) {
           mOnceOnly = true;   // this has to stop firing now that the proxy to the delegate points to something that is now gone
           break;
@@ -184,11 +225,7 @@ namespace zsLib
         }
       }
 
-      if (!mOnceOnly) {
-		  Microseconds diff = std::chrono::duration_cast<Microseconds>(mFireNextAt - time);
-        if (diff < sleepTime)
-          sleepTime = diff;
-      }
+      outFireNextAt = mFireNextAt;
 
       if (!fired)
         return false;
@@ -207,19 +244,31 @@ namespace zsLib
                             ITimerDelegatePtr delegate,
                             Microseconds timeout,
                             bool repeat,
-                            size_t maxFiringTimerAtOnce
+                            size_t maxFiringTimerAtOnce,
+                            Microseconds tolerance
                             )
   {
-    return internal::Timer::create(delegate, timeout, repeat, maxFiringTimerAtOnce);
+    return internal::Timer::create(delegate, timeout, repeat, maxFiringTimerAtOnce, tolerance);
+  }
+
+  //---------------------------------------------------------------------------
+  ITimerPtr ITimer::create(
+                           ITimerDelegatePtr delegate,
+                           Time timeout,
+                           Microseconds tolerance
+                           )
+  {
+    return internal::Timer::create(delegate, timeout, tolerance);
   }
 
   //---------------------------------------------------------------------------
   ITimerPtr ITimer::create(
                            ITimerDelegatePtr delegate,
-                           Time timeout
+                           SteadyTime timeout,
+                           Microseconds tolerance
                            )
   {
-    return internal::Timer::create(delegate, timeout);
+    return internal::Timer::create(delegate, timeout, tolerance);
   }
 
 } // namespace zsLib
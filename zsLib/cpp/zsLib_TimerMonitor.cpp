@@ -41,6 +41,13 @@
 #include <sys/time.h>
 #endif //__QNX__
 
+#ifdef HAVE_TIMERFD
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif //HAVE_TIMERFD
+
 namespace zsLib {ZS_DECLARE_SUBSYSTEM(zsLib)}
 
 namespace zsLib
@@ -85,6 +92,8 @@ namespace zsLib
       virtual void notifySettingsApplyDefaults() override
       {
         ISettings::setString(ZSLIB_SETTING_TIMER_MONITOR_THREAD_PRIORITY, "normal");
+        ISettings::setBool(ZSLIB_SETTING_TIMER_MONITOR_USE_TIMERFD, false);
+        ISettings::setUInt(ZSLIB_SETTING_TIMER_MONITOR_TOTAL_SHARDS, 1);
       }
     };
 
@@ -94,6 +103,65 @@ namespace zsLib
       TimerMonitorSettingsDefaults::singleton();
     }
 
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerMonitorFiringMessage
+    #pragma mark
+
+    class TimerMonitorFiringMessage : public IMessageQueueMessage
+    {
+    public:
+      typedef TimerMonitor::TimerFiringList TimerFiringList;
+
+      //-----------------------------------------------------------------------
+      TimerMonitorFiringMessage(TimerFiringList &&firings) :
+        mFirings(std::move(firings))
+      {
+      }
+
+      //-----------------------------------------------------------------------
+      virtual const char *getDelegateName() const override {return typeid(ITimerDelegate).name();}
+      virtual const char *getMethodName() const override {return "onTimer";}
+
+      //-----------------------------------------------------------------------
+      virtual void processMessage() override
+      {
+        std::exception_ptr firstException;
+
+        for (auto iter = mFirings.begin(); iter != mFirings.end(); ++iter)
+        {
+          auto &firing = (*iter);
+          try {
+            auto delegate = firing.mDelegate.lock();
+            if (!delegate) continue;                                                  // released while queued (same as DelegateGone)
+            delegate->onTimer(firing.mTimer);
+          } catch (ITimerDelegateProxy::Exceptions::DelegateGone &) {
+          } catch (...) {
+            // a throwing delegate must not prevent the other timers in the
+            // batch from firing (as each firing was once its own message)
+            ZS_LOG_WARNING(Detail, TimerMonitor::slog("timer delegate threw an exception") + ZS_PARAM("timer", firing.mTimer ? firing.mTimer->getID() : 0))
+            if (!firstException) firstException = std::current_exception();
+          }
+        }
+
+        if (firstException) std::rethrow_exception(firstException);
+      }
+
+    protected:
+      TimerFiringList mFirings;
+    };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark TimerMonitor
+    #pragma mark
+
     //-------------------------------------------------------------------------
     TimerMonitor::TimerMonitor() :
       mShouldShutdown(false)
@@ -111,6 +179,12 @@ namespace zsLib
     //-------------------------------------------------------------------------
     void TimerMonitor::init()
     {
+#ifdef HAVE_TIMERFD
+      mTimerFDRequested = ISettings::getBool(ZSLIB_SETTING_TIMER_MONITOR_USE_TIMERFD);
+#endif //HAVE_TIMERFD
+
+      // the shards are fixed once created so picking a shard never locks
+      createShards(ISettings::getUInt(ZSLIB_SETTING_TIMER_MONITOR_TOTAL_SHARDS));
     }
 
     //-------------------------------------------------------------------------
@@ -124,6 +198,10 @@ namespace zsLib
       pthread_cond_destroy(&mCondition);
       pthread_mutex_destroy(&mMutex);
 #endif //__QNX__
+
+#ifdef HAVE_TIMERFD
+      closeTimerFD();
+#endif //HAVE_TIMERFD
     }
 
     //-------------------------------------------------------------------------
@@ -148,18 +226,67 @@ namespace zsLib
       return pThis;
     }
 
+    //-------------------------------------------------------------------------
+    TimerMonitorPtr TimerMonitor::monitorFor(IMessageQueuePtr queue)
+    {
+      TimerMonitorPtr pThis = singleton();
+      if (!pThis) return pThis;
+
+      if (pThis->mShards.size() < 1) return pThis;
+
+      // timers are assigned to a shard by their delegate's queue (or the
+      // creating thread if there is no queue) so that unrelated timers
+      // are armed, cancelled and fired on independent monitors
+      size_t hash = 0;
+      if (queue) {
+        PTRNUMBER value = reinterpret_cast<PTRNUMBER>(queue.get());
+        hash = static_cast<size_t>(value ^ (value >> 7) ^ (value >> 17));
+      } else {
+        hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+      }
+
+      size_t index = hash % (pThis->mShards.size() + 1);
+      if (0 == index) return pThis;
+
+      return pThis->mShards[index - 1];
+    }
+
     //-------------------------------------------------------------------------
     void TimerMonitor::monitorBegin(TimerPtr timer)
     {
       AutoRecursiveLock lock(mLock);
 
       if (!mThread) {
+#ifdef HAVE_TIMERFD
+        mUseTimerFD = (mTimerFDRequested ? openTimerFD() : false);
+        if (!mUseTimerFD) closeTimerFD();
+#endif //HAVE_TIMERFD
         mThread = ThreadPtr(new std::thread(std::ref(*this)));
         setThreadPriority(mThread->native_handle(), zsLib::threadPriorityFromString(ISettings::getString(ZSLIB_SETTING_TIMER_MONITOR_THREAD_PRIORITY)));
       }
 
       PUID timerID = timer->getID();
-      mMonitoredTimers[timerID] = TimerWeakPtr(timer);
+
+      SteadyTime fireAt {};
+      {
+        AutoRecursiveLock timerLock(timer->mLock);
+        fireAt = timer->mFireNextAt;
+      }
+
+      TimerInfo &info = mMonitoredTimers[timerID];
+      info.mTimer = timer;
+      info.mTolerance = timer->mTolerance;
+      info.mScheduled = mSchedule.end();
+
+      schedule(timerID, info, fireAt);
+
+      // only need to wake up the monitor if this timer cannot wait until the
+      // monitor's already planned wake-up
+      SteadyTime latestFireAt = fireAt + info.mTolerance;
+      if ((SteadyTime() != mWakeUpAt) &&
+          (latestFireAt >= mWakeUpAt)) return;
+
+      mWakeUpAt = latestFireAt;
       wakeUp();
     }
 
@@ -174,8 +301,12 @@ namespace zsLib
       if (mMonitoredTimers.end() == result)
         return;
 
+      auto &info = (*result).second;
+      if (mSchedule.end() != info.mScheduled) {
+        mSchedule.erase(info.mScheduled);
+      }
+
       mMonitoredTimers.erase(result);
-      wakeUp();
     }
 
     //-------------------------------------------------------------------------
@@ -196,42 +327,9 @@ namespace zsLib
           duration = fireTimers();
         }
 
-#ifdef __QNX__
-        struct timeval tp;
-        struct timespec ts;
-        memset(&tp, 0, sizeof(tp));
-        memset(&ts, 0, sizeof(ts));
-
-        int rc =  gettimeofday(&tp, NULL);
-        ZS_THROW_BAD_STATE_IF(0 != rc)
-
-        // Convert from timeval to timespec
-        ts.tv_sec  = tp.tv_sec;
-        ts.tv_nsec = tp.tv_usec * 1000;
-
-        // add the time to expire from now
-        ts.tv_sec += duration.seconds();
-        ts.tv_nsec += ((duration - Seconds(duration.total_seconds()))).total_nanoseconds();
-
-        // this could have caused tv_nsec to wrapped above second mark since it started in absolute time since epoch
-        if (ts.tv_nsec >= (Seconds(1).total_nanoseconds())) {
-          Duration wrapSeconds = Seconds(ts.tv_nsec / (Seconds(1).total_nanoseconds()));
-          ts.tv_sec += wrapSeconds.total_seconds();
-          ts.tv_nsec -= wrapSeconds.total_nanoseconds();
-        }
-
-        rc = pthread_mutex_lock(&mMutex);
-        ZS_THROW_BAD_STATE_IF(0 != rc)
+        if (shouldShutdown) break;  // no need to sleep once shutdown has been requested
 
-        rc = pthread_cond_timedwait(&mCondition, &mMutex, &ts);
-        ZS_THROW_BAD_STATE_IF((0 != rc) && (ETIMEDOUT != rc))
-
-        rc = pthread_mutex_unlock(&mMutex);
-        ZS_THROW_BAD_STATE_IF(0 != rc)
-#else
-        std::unique_lock<std::mutex> flagLock(mFlagLock);
-        mFlagNotify.wait_for(flagLock, duration);
-#endif //__QNX__
+        wait(duration);
 
         // notify all those timers needing to be notified
       } while (!shouldShutdown);
@@ -250,11 +348,12 @@ namespace zsLib
           TimerMap::iterator current = monIter;
           ++monIter;
 
-          TimerPtr timer = current->second.lock();
+          TimerPtr timer = current->second.mTimer.lock();
           if (timer)
             timer->background(false);
         }
         mMonitoredTimers.clear();
+        mSchedule.clear();
       }
     }
 
@@ -262,6 +361,10 @@ namespace zsLib
     void TimerMonitor::notifySingletonCleanup()
     {
       cancel();
+
+      for (auto iter = mShards.begin(); iter != mShards.end(); ++iter) {
+        (*iter)->cancel();
+      }
     }
 
     //-----------------------------------------------------------------------
@@ -292,10 +395,12 @@ namespace zsLib
       ThreadPtr thread;
       {
         AutoRecursiveLock lock(mLock);
-        mGracefulShutdownReference = mThisWeak.lock();
         thread = mThread;
         mThread.reset();
 
+        // only a running thread releases the graceful shutdown reference
+        if (thread) mGracefulShutdownReference = mThisWeak.lock();
+
         mShouldShutdown = true;
         wakeUp();
       }
@@ -308,32 +413,205 @@ namespace zsLib
       }
     }
 
+    //-------------------------------------------------------------------------
+    void TimerMonitor::createShards(ULONG totalShards)
+    {
+      // this monitor acts as the first shard
+      for (ULONG index = 1; index < totalShards; ++index) {
+        TimerMonitorPtr shard(new TimerMonitor);
+        shard->mThisWeak = shard;
+#ifdef HAVE_TIMERFD
+        shard->mTimerFDRequested = mTimerFDRequested;
+#endif //HAVE_TIMERFD
+        mShards.push_back(shard);
+      }
+
+      if (mShards.size() > 0) {
+        ZS_LOG_DETAIL(log("sharding timers") + ZS_PARAM("total shards", totalShards))
+      }
+    }
+
     //-------------------------------------------------------------------------
     Microseconds TimerMonitor::fireTimers()
     {
       AutoRecursiveLock lock(mLock);
 
-      Time time = std::chrono::system_clock::now();
+      SteadyTime time = zsLib::steadyNow();
 
       Microseconds duration = Seconds(1);
+#ifdef HAVE_TIMERFD
+      if (mUseTimerFD)
+        duration = Hours(1);  // every change to the schedule signals the wake-up fd so there is nothing to poll for
+#endif //HAVE_TIMERFD
+
+      typedef std::list<PUID> TimerIDList;
+      TimerIDList expired;
 
-      for (TimerMap::iterator monIter = mMonitoredTimers.begin(); monIter != mMonitoredTimers.end(); )
+      // scope: remove all expired timers from the schedule before firing
+      // them so a timer which reschedules itself at or before the current
+      // time is not visited twice in the same pass
       {
-        TimerMap::iterator current = monIter;
-        ++monIter;
+        while (mSchedule.size() > 0) {
+          auto iter = mSchedule.begin();
+          if ((*iter).first > time) break;
+
+          PUID timerID = (*iter).second.mID;
+          mSchedule.erase(iter);
+
+          auto found = mMonitoredTimers.find(timerID);
+          if (found == mMonitoredTimers.end()) continue;
+
+          (*found).second.mScheduled = mSchedule.end();
+          expired.push_back(timerID);
+        }
+      }
+
+      QueueFiringMap firings;
+
+      for (auto iter = expired.begin(); iter != expired.end(); ++iter)
+      {
+        PUID timerID = (*iter);
+
+        auto found = mMonitoredTimers.find(timerID);
+        if (found == mMonitoredTimers.end()) continue;
+
+        auto &info = (*found).second;
 
-        TimerPtr timer = (current->second).lock();
+        TimerPtr timer = info.mTimer.lock();
         bool done = true;
+        SteadyTime fireAt {};
 
-        if (timer)
-          done = timer->tick(time, duration);
+        if (timer) {
+          IMessageQueuePtr queue;
+          ITimerDelegatePtr delegate;
+          size_t totalFirings = 0;
 
-        if (done)
-          mMonitoredTimers.erase(current);
+          done = timer->tick(time, fireAt, queue, delegate, totalFirings);
+
+          if (totalFirings > 0) {
+            TimerFiring firing;
+            firing.mDelegate = delegate;
+            firing.mTimer = timer;
+
+            auto &queueFirings = firings[queue];
+            queueFirings.insert(queueFirings.end(), totalFirings, firing);
+          }
+        }
+
+        if (done) {
+          mMonitoredTimers.erase(found);
+          continue;
+        }
+
+        schedule(timerID, info, fireAt);
+      }
+
+      deliver(firings);
+
+      // Sleep until the earliest moment any timer must fire (i.e. its fire
+      // time plus its tolerance). Every timer due by then fires in that same
+      // wake-up. Only timers scheduled before the current candidate wake-up
+      // can pull it earlier so the scan stops at the first one that cannot.
+      SteadyTime wakeUpAt = time + duration;
+      for (auto iter = mSchedule.begin(); iter != mSchedule.end(); ++iter) {
+        const SteadyTime &fireAt = (*iter).first;
+        if (fireAt >= wakeUpAt) break;
+
+        SteadyTime latestFireAt = fireAt + (*iter).second.mTolerance;
+        if (latestFireAt < wakeUpAt)
+          wakeUpAt = latestFireAt;
       }
+
+      mWakeUpAt = wakeUpAt;
+      duration = (wakeUpAt > time ? std::chrono::duration_cast<Microseconds>(wakeUpAt - time) : Microseconds());
+
       return duration;
     }
 
+    //-------------------------------------------------------------------------
+    void TimerMonitor::wait(Microseconds duration)
+    {
+#ifdef __QNX__
+      struct timeval tp;
+      struct timespec ts;
+      memset(&tp, 0, sizeof(tp));
+      memset(&ts, 0, sizeof(ts));
+
+      int rc =  gettimeofday(&tp, NULL);
+      ZS_THROW_BAD_STATE_IF(0 != rc)
+
+      // Convert from timeval to timespec
+      ts.tv_sec  = tp.tv_sec;
+      ts.tv_nsec = tp.tv_usec * 1000;
+
+      // add the time to expire from now
+      ts.tv_sec += duration.seconds();
+      ts.tv_nsec += ((duration - Seconds(duration.total_seconds()))).total_nanoseconds();
+
+      // this could have caused tv_nsec to wrapped above second mark since it started in absolute time since epoch
+      if (ts.tv_nsec >= (Seconds(1).total_nanoseconds())) {
+        Duration wrapSeconds = Seconds(ts.tv_nsec / (Seconds(1).total_nanoseconds()));
+        ts.tv_sec += wrapSeconds.total_seconds();
+        ts.tv_nsec -= wrapSeconds.total_nanoseconds();
+      }
+
+      rc = pthread_mutex_lock(&mMutex);
+      ZS_THROW_BAD_STATE_IF(0 != rc)
+
+      rc = pthread_cond_timedwait(&mCondition, &mMutex, &ts);
+      ZS_THROW_BAD_STATE_IF((0 != rc) && (ETIMEDOUT != rc))
+
+      rc = pthread_mutex_unlock(&mMutex);
+      ZS_THROW_BAD_STATE_IF(0 != rc)
+#else
+
+#ifdef HAVE_TIMERFD
+      if (mUseTimerFD) {
+        waitTimerFD(duration);
+        return;
+      }
+#endif //HAVE_TIMERFD
+
+      std::unique_lock<std::mutex> flagLock(mFlagLock);
+      auto &wakeUpPending = mWakeUpPending;
+      mFlagNotify.wait_for(flagLock, duration, [&wakeUpPending]() { return wakeUpPending; });
+      mWakeUpPending = false;
+#endif //__QNX__
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerMonitor::deliver(QueueFiringMap &firings)
+    {
+      for (auto iter = firings.begin(); iter != firings.end(); ++iter)
+      {
+        auto &queue = (*iter).first;
+        auto &queueFirings = (*iter).second;
+
+        try {
+          queue->post(IMessageQueueMessageUniPtr(new TimerMonitorFiringMessage(std::move(queueFirings))));
+        } catch (IMessageQueue::Exceptions::MessageQueueGone &) {
+          ZS_LOG_WARNING(Debug, log("unable to deliver timer firings as message queue is gone"))
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerMonitor::schedule(
+                                PUID timerID,
+                                TimerInfo &info,
+                                const SteadyTime &fireAt
+                                )
+    {
+      if (mSchedule.end() != info.mScheduled) {
+        mSchedule.erase(info.mScheduled);
+      }
+      ScheduledTimer scheduled;
+      scheduled.mID = timerID;
+      scheduled.mTolerance = info.mTolerance;
+
+      info.mScheduled = mSchedule.insert(TimerSchedule::value_type(fireAt, scheduled));
+    }
+
     //-------------------------------------------------------------------------
     void TimerMonitor::wakeUp()
     {
@@ -348,8 +626,93 @@ namespace zsLib
       ZS_THROW_BAD_STATE_IF(0 != rc)
 
 #else
+
+#ifdef HAVE_TIMERFD
+      if (mUseTimerFD) {
+        uint64_t value = 1;
+        auto result = ::write(mWakeUpFD, &value, sizeof(value));
+        (void)result; // the eventfd counter cannot overflow from wake-ups and a wake-up already pending is sufficient
+        return;
+      }
+#endif //HAVE_TIMERFD
+
+      std::lock_guard<std::mutex> flagLock(mFlagLock);
+      mWakeUpPending = true;
       mFlagNotify.notify_one();
 #endif //__QNX__
     }
+
+#ifdef HAVE_TIMERFD
+    //-------------------------------------------------------------------------
+    bool TimerMonitor::openTimerFD()
+    {
+      closeTimerFD();
+
+      mTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      mWakeUpFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+      if ((-1 == mTimerFD) ||
+          (-1 == mWakeUpFD)) {
+        ZS_LOG_WARNING(Basic, log("unable to create timerfd (falling back to condition variable)") + ZS_PARAM("errno", errno))
+        closeTimerFD();
+        return false;
+      }
+
+      ZS_LOG_DETAIL(log("using timerfd") + ZS_PARAM("timer fd", mTimerFD) + ZS_PARAM("wake up fd", mWakeUpFD))
+      return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerMonitor::closeTimerFD()
+    {
+      if (-1 != mTimerFD) {
+        ::close(mTimerFD);
+        mTimerFD = -1;
+      }
+      if (-1 != mWakeUpFD) {
+        ::close(mWakeUpFD);
+        mWakeUpFD = -1;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+    void TimerMonitor::waitTimerFD(Microseconds duration)
+    {
+      // the deadline is armed as an absolute CLOCK_MONOTONIC time so the
+      // wait is unaffected by wall clock adjustments and how long it takes
+      // to get from here to the poll
+      struct timespec now {};
+      clock_gettime(CLOCK_MONOTONIC, &now);
+
+      auto deadline = std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec) + duration;
+      auto deadlineSeconds = std::chrono::duration_cast<std::chrono::seconds>(deadline);
+
+      struct itimerspec spec {};
+      spec.it_value.tv_sec = static_cast<decltype(spec.it_value.tv_sec)>(deadlineSeconds.count());
+      spec.it_value.tv_nsec = static_cast<decltype(spec.it_value.tv_nsec)>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - deadlineSeconds).count());
+
+      int rc = timerfd_settime(mTimerFD, TFD_TIMER_ABSTIME, &spec, NULL);
+      ZS_THROW_BAD_STATE_IF(0 != rc)
+
+      struct pollfd fds[2] {};
+      fds[0].fd = mTimerFD;
+      fds[0].events = POLLIN;
+      fds[1].fd = mWakeUpFD;
+      fds[1].events = POLLIN;
+
+      rc = poll(fds, 2, -1);
+      ZS_THROW_BAD_STATE_IF((-1 == rc) && (EINTR != errno))
+
+      uint64_t value = 0;
+      if (0 != (fds[0].revents & POLLIN)) {
+        auto result = ::read(mTimerFD, &value, sizeof(value));
+        (void)result;
+      }
+      if (0 != (fds[1].revents & POLLIN)) {
+        auto result = ::read(mWakeUpFD, &value, sizeof(value));
+        (void)result;
+      }
+    }
+#endif //HAVE_TIMERFD
   }
 }
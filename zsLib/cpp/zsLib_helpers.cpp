@@ -253,4 +253,58 @@ namespace zsLib
   {
     return std::chrono::system_clock::now();
   }
+
+  //---------------------------------------------------------------------------
+  SteadyTime steadyNow()
+  {
+    return std::chrono::steady_clock::now();
+  }
+
+  //---------------------------------------------------------------------------
+  SteadyTime toSteadyTime(Time time)
+  {
+    auto steady = steadyNow();
+    auto current = now();
+    if (time <= current) return steady - std::chrono::duration_cast<SteadyTime::duration>(current - time);
+    return steady + std::chrono::duration_cast<SteadyTime::duration>(time - current);
+  }
+
+  //---------------------------------------------------------------------------
+  Time coarseNow()
+  {
+#ifdef HAVE_CLOCK_COARSE
+    struct timespec ts {};
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+    return Time(std::chrono::duration_cast<Time::duration>(Seconds(ts.tv_sec) + Nanoseconds(ts.tv_nsec)));
+#else
+    return now();
+#endif //HAVE_CLOCK_COARSE
+  }
+
+  //---------------------------------------------------------------------------
+  SteadyTime coarseSteadyNow()
+  {
+#ifdef HAVE_CLOCK_COARSE
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return SteadyTime(std::chrono::duration_cast<SteadyTime::duration>(Seconds(ts.tv_sec) + Nanoseconds(ts.tv_nsec)));
+#else
+    return steadyNow();
+#endif //HAVE_CLOCK_COARSE
+  }
+
+  //---------------------------------------------------------------------------
+  Microseconds coarseClockResolution()
+  {
+#ifdef HAVE_CLOCK_COARSE
+    static Microseconds resolution = []() -> Microseconds {
+      struct timespec ts {};
+      if (0 != clock_getres(CLOCK_MONOTONIC_COARSE, &ts)) return Milliseconds(10);
+      return std::chrono::duration_cast<Microseconds>(Seconds(ts.tv_sec) + Nanoseconds(ts.tv_nsec));
+    }();
+    return resolution;
+#else
+    return Microseconds(1);
+#endif //HAVE_CLOCK_COARSE
+  }
 }
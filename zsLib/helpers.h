@@ -56,6 +56,33 @@ namespace zsLib
   //---------------------------------------------------------------------------
   Time now();
 
+  //---------------------------------------------------------------------------
+  // PURPOSE: Returns the current monotonic time. Unlike "now()" this time is
+  //          never adjusted (e.g. by NTP or the user changing the clock) and
+  //          is the time used for timers and deadlines.
+  SteadyTime steadyNow();
+
+  //---------------------------------------------------------------------------
+  // PURPOSE: Converts a wall clock time into the equivalent monotonic time
+  //          based upon the current offset between the two clocks.
+  SteadyTime toSteadyTime(Time time);
+
+  //---------------------------------------------------------------------------
+  // PURPOSE: Returns the current wall clock / monotonic time from a cheap,
+  //          coarse clock source for use in hot paths (e.g. timestamping).
+  // NOTES:   On Linux these read CLOCK_REALTIME_COARSE and
+  //          CLOCK_MONOTONIC_COARSE which avoid the cost of a precise clock
+  //          read but only advance once per kernel tick (typically 1-4ms).
+  //          Use "coarseClockResolution()" to obtain the actual precision.
+  //          Platforms without a coarse clock source return the precise
+  //          time instead.
+  Time coarseNow();
+  SteadyTime coarseSteadyNow();
+
+  //---------------------------------------------------------------------------
+  // PURPOSE: Returns the precision of "coarseNow()" and "coarseSteadyNow()".
+  Microseconds coarseClockResolution();
+
   template <typename duration_type>
   inline duration_type timeSinceEpoch(Time time)
   {
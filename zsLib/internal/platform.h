@@ -49,6 +49,19 @@
 #undef HAVE_RAISEEXCEPTION
 #undef HAVE_SPRINTF_S
 #undef HAVE_STRCPY_S
+#undef HAVE_TIMERFD
+#undef HAVE_CLOCK_COARSE
+#undef HAVE_EPOLL
+#undef HAVE_EVENTFD
+#undef HAVE_RECVMMSG
+#undef HAVE_SENDMMSG
+#undef HAVE_SENDFILE
+#undef HAVE_MSG_ZEROCOPY
+#undef HAVE_IO_URING
+#undef HAVE_UDP_GSO
+#undef HAVE_ACCEPT4
+#undef HAVE_PTHREAD_SETAFFINITY_NP
+#undef HAVE_PTHREAD_GETCPUCLOCKID
 
 #ifdef _WIN32
 
@@ -124,4 +137,27 @@
 #endif //_ANDROID
 #endif //_LINUX
 
+
+#ifdef __linux__
+
+// Linux kernel facilities (available to both Linux and Android)
+#define HAVE_TIMERFD 1
+#define HAVE_CLOCK_COARSE 1
+#define HAVE_EPOLL 1
+#define HAVE_EVENTFD 1
+#define HAVE_RECVMMSG 1
+#define HAVE_SENDMMSG 1
+#define HAVE_SENDFILE 1
+#define HAVE_MSG_ZEROCOPY 1
+#define HAVE_ACCEPT4 1
+
+#ifndef _ANDROID
+#define HAVE_IO_URING 1
+#define HAVE_UDP_GSO 1
+#define HAVE_PTHREAD_SETAFFINITY_NP 1
+#define HAVE_PTHREAD_GETCPUCLOCKID 1
+#endif //ndef _ANDROID
+
+#endif //__linux__
+
 #endif //ZSLIB_INTERNAL_PLATFORM_H_ae1ca1614cb82fd6e3e9751af73f2658
@@ -1475,6 +1475,59 @@ namespace zsLib {
     ZS_EVENTING_WRITE_EVENT(::zsLib::eventing::getEventHandle_zsLib(), Informational, Detail, ::zsLib::eventing::getEventDescriptor_SocketListen(), ::zsLib::eventing::getEventParameterDescriptor_SocketListen(), &(xxDescriptors[0]), 5); \
   }
 
+    inline const USE_EVENT_DESCRIPTOR *getEventDescriptor_SocketMonitorStatistics()
+    {
+      static const USE_EVENT_DESCRIPTOR description {1056, 0, 0, 4, 0, 4, (0x8000000000000000ULL)};
+      return &description;
+    }
+
+    inline const USE_EVENT_PARAMETER_DESCRIPTOR *getEventParameterDescriptor_SocketMonitorStatistics()
+    {
+      static const USE_EVENT_PARAMETER_DESCRIPTOR descriptions [] =
+      {
+        {EventParameterType_AString},
+        {EventParameterType_AString},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger}
+      };
+      return &(descriptions[0]);
+    }
+
+#define ZS_INTERNAL_EVENTING_EVENT_SocketMonitorStatistics(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6, xValue7, xValue8) \
+  if (ZS_EVENTING_IS_LOGGING(::zsLib::eventing::getEventHandle_zsLib(), (0x8000000000000000ULL), Debug)) { \
+    ::zsLib::eventing::USE_EVENT_DATA_DESCRIPTOR xxDescriptors[11]; \
+    uint32_t xxLineNumber = __LINE__; \
+    \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_ASTR(&(xxDescriptors[0]), (ZS_GET_SUBSYSTEM()).getName()); \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_ASTR(&(xxDescriptors[1]), __func__); \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[2]), &xxLineNumber, sizeof(xxLineNumber)); \
+    \
+    uint64_t xxVal3{(xValue1)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[3]), &(xxVal3), sizeof(xxVal3)); \
+    uint64_t xxVal4{(xValue2)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[4]), &(xxVal4), sizeof(xxVal4)); \
+    uint64_t xxVal5{(xValue3)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[5]), &(xxVal5), sizeof(xxVal5)); \
+    uint64_t xxVal6{(xValue4)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[6]), &(xxVal6), sizeof(xxVal6)); \
+    uint64_t xxVal7{(xValue5)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[7]), &(xxVal7), sizeof(xxVal7)); \
+    uint64_t xxVal8{(xValue6)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[8]), &(xxVal8), sizeof(xxVal8)); \
+    uint64_t xxVal9{(xValue7)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[9]), &(xxVal9), sizeof(xxVal9)); \
+    uint64_t xxVal10{(xValue8)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[10]), &(xxVal10), sizeof(xxVal10)); \
+    ZS_EVENTING_WRITE_EVENT(::zsLib::eventing::getEventHandle_zsLib(), Informational, Debug, ::zsLib::eventing::getEventDescriptor_SocketMonitorStatistics(), ::zsLib::eventing::getEventParameterDescriptor_SocketMonitorStatistics(), &(xxDescriptors[0]), 11); \
+  }
+
     inline const USE_EVENT_DESCRIPTOR *getEventDescriptor_SocketOrphan()
     {
       static const USE_EVENT_DESCRIPTOR description {1039, 0, 0, 4, 18, 4, (0x8000000000000000ULL)};
@@ -1885,6 +1938,74 @@ namespace zsLib {
     ZS_EVENTING_WRITE_EVENT(::zsLib::eventing::getEventHandle_zsLib(), Informational, Debug, ::zsLib::eventing::getEventDescriptor_SocketShutdown(), ::zsLib::eventing::getEventParameterDescriptor_SocketShutdown(), &(xxDescriptors[0]), 6); \
   }
 
+    inline const USE_EVENT_DESCRIPTOR *getEventDescriptor_SocketStatistics()
+    {
+      static const USE_EVENT_DESCRIPTOR description {1055, 0, 0, 4, 0, 4, (0x8000000000000000ULL)};
+      return &description;
+    }
+
+    inline const USE_EVENT_PARAMETER_DESCRIPTOR *getEventParameterDescriptor_SocketStatistics()
+    {
+      static const USE_EVENT_PARAMETER_DESCRIPTOR descriptions [] =
+      {
+        {EventParameterType_AString},
+        {EventParameterType_AString},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger},
+        {EventParameterType_UnsignedInteger}
+      };
+      return &(descriptions[0]);
+    }
+
+#define ZS_INTERNAL_EVENTING_EVENT_SocketStatistics(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6, xValue7, xValue8, xValue9, xValue10, xValue11, xValue12, xValue13) \
+  if (ZS_EVENTING_IS_LOGGING(::zsLib::eventing::getEventHandle_zsLib(), (0x8000000000000000ULL), Debug)) { \
+    ::zsLib::eventing::USE_EVENT_DATA_DESCRIPTOR xxDescriptors[16]; \
+    uint32_t xxLineNumber = __LINE__; \
+    \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_ASTR(&(xxDescriptors[0]), (ZS_GET_SUBSYSTEM()).getName()); \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_ASTR(&(xxDescriptors[1]), __func__); \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[2]), &xxLineNumber, sizeof(xxLineNumber)); \
+    \
+    uint64_t xxVal3{(xValue1)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[3]), &(xxVal3), sizeof(xxVal3)); \
+    uint64_t xxVal4{(xValue2)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[4]), &(xxVal4), sizeof(xxVal4)); \
+    uint64_t xxVal5{(xValue3)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[5]), &(xxVal5), sizeof(xxVal5)); \
+    uint64_t xxVal6{(xValue4)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[6]), &(xxVal6), sizeof(xxVal6)); \
+    uint64_t xxVal7{(xValue5)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[7]), &(xxVal7), sizeof(xxVal7)); \
+    uint64_t xxVal8{(xValue6)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[8]), &(xxVal8), sizeof(xxVal8)); \
+    uint64_t xxVal9{(xValue7)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[9]), &(xxVal9), sizeof(xxVal9)); \
+    uint64_t xxVal10{(xValue8)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[10]), &(xxVal10), sizeof(xxVal10)); \
+    uint64_t xxVal11{(xValue9)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[11]), &(xxVal11), sizeof(xxVal11)); \
+    uint64_t xxVal12{(xValue10)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[12]), &(xxVal12), sizeof(xxVal12)); \
+    uint64_t xxVal13{(xValue11)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[13]), &(xxVal13), sizeof(xxVal13)); \
+    uint64_t xxVal14{(xValue12)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[14]), &(xxVal14), sizeof(xxVal14)); \
+    uint64_t xxVal15{(xValue13)}; \
+    ZS_EVENTING_EVENT_DATA_DESCRIPTOR_FILL_VALUE(&(xxDescriptors[15]), &(xxVal15), sizeof(xxVal15)); \
+    ZS_EVENTING_WRITE_EVENT(::zsLib::eventing::getEventHandle_zsLib(), Informational, Debug, ::zsLib::eventing::getEventDescriptor_SocketStatistics(), ::zsLib::eventing::getEventParameterDescriptor_SocketStatistics(), &(xxDescriptors[0]), 16); \
+  }
+
     inline const USE_EVENT_DESCRIPTOR *getEventDescriptor_SocketWouldBlock()
     {
       static const USE_EVENT_DESCRIPTOR description {1049, 0, 0, 5, 0, 4, (0x8000000000000000ULL)};
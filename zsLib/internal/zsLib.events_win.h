@@ -442,6 +442,7 @@
 #define ZS_INTERNAL_EVENTING_EVENT_SocketGetOptions(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketGetOptions(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2), static_cast<int64_t>(xValue3), static_cast<int64_t>(xValue4), static_cast<size_t>(xValue6), reinterpret_cast<const BYTE *>(xValue5)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketGetRemoteAddress(xSubsystem, xValue1, xValue2, xValue3, xValue4) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketGetRemoteAddress(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2), static_cast<size_t>(xValue4), reinterpret_cast<const BYTE *>(xValue3)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketListen(xSubsystem, xValue1, xValue2) ZS_EVENTING_IS_LOGGING(Detail) { EventWriteSocketListen(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2)); }
+#define ZS_INTERNAL_EVENTING_EVENT_SocketMonitorStatistics(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6, xValue7, xValue8) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketMonitorStatistics(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<uint64_t>(xValue2), static_cast<uint64_t>(xValue3), static_cast<uint64_t>(xValue4), static_cast<uint64_t>(xValue5), static_cast<uint64_t>(xValue6), static_cast<uint64_t>(xValue7), static_cast<uint64_t>(xValue8)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketOrphan(xSubsystem, xValue1) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketOrphan(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketReadReadyEvent(xSubsystem, xValue1) ZS_EVENTING_IS_LOGGING(Insane) { EventWriteSocketReadReadyEvent(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, reinterpret_cast<const void *>(xValue1)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketReadReadyReset(xSubsystem, xValue1) ZS_EVENTING_IS_LOGGING(Insane) { EventWriteSocketReadReadyReset(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1)); }
@@ -452,6 +453,7 @@
 #define ZS_INTERNAL_EVENTING_EVENT_SocketSetOption(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketSetOption(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2), static_cast<int64_t>(xValue3), static_cast<int64_t>(xValue4), static_cast<size_t>(xValue6), reinterpret_cast<const BYTE *>(xValue5)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketSetOptionFlag(xSubsystem, xValue1, xValue2, xValue3, xValue4) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketSetOptionFlag(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2), static_cast<int64_t>(xValue3), (bool)(xValue4)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketShutdown(xSubsystem, xValue1, xValue2, xValue3) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketShutdown(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<int64_t>(xValue2), static_cast<int64_t>(xValue3)); }
+#define ZS_INTERNAL_EVENTING_EVENT_SocketStatistics(xSubsystem, xValue1, xValue2, xValue3, xValue4, xValue5, xValue6, xValue7, xValue8, xValue9, xValue10, xValue11, xValue12, xValue13) ZS_EVENTING_IS_LOGGING(Debug) { EventWriteSocketStatistics(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), static_cast<uint64_t>(xValue2), static_cast<uint64_t>(xValue3), static_cast<uint64_t>(xValue4), static_cast<uint64_t>(xValue5), static_cast<uint64_t>(xValue6), static_cast<uint64_t>(xValue7), static_cast<uint64_t>(xValue8), static_cast<uint64_t>(xValue9), static_cast<uint64_t>(xValue10), static_cast<uint64_t>(xValue11), static_cast<uint64_t>(xValue12), static_cast<uint64_t>(xValue13)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketWouldBlock(xSubsystem, xValue1, xValue2) ZS_EVENTING_IS_LOGGING(Trace) { EventWriteSocketWouldBlock(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1), (bool)(xValue2)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketWriteReadyEvent(xSubsystem, xValue1) ZS_EVENTING_IS_LOGGING(Insane) { EventWriteSocketWriteReadyEvent(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, reinterpret_cast<const void *>(xValue1)); }
 #define ZS_INTERNAL_EVENTING_EVENT_SocketWriteReadyReset(xSubsystem, xValue1) ZS_EVENTING_IS_LOGGING(Insane) { EventWriteSocketWriteReadyReset(ZS_EVENTING_GET_CURRENT_SUBSYSTEM_NAME(), __func__, __LINE__, static_cast<uint64_t>(xValue1)); }
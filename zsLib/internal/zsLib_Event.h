@@ -34,6 +34,8 @@
 
 #include <zsLib/types.h>
 #include <condition_variable>
+#include <vector>
+#include <list>
 
 #ifdef _WIN32
 #define ZSLIB_INTERNAL_USE_WIN32_EVENT
@@ -52,6 +54,34 @@ namespace zsLib
       Event(const Event &) = delete;
 
     protected:
+      typedef SteadyTime WaitTime;
+
+#ifndef ZSLIB_INTERNAL_USE_WIN32_EVENT
+      struct AnyWaiter
+      {
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mSignalled {};
+      };
+
+      typedef std::list<AnyWaiter *> AnyWaiterList;
+
+      bool consume();
+      void addWaiter(AnyWaiter &waiter);
+      void removeWaiter(AnyWaiter &waiter);
+#endif //ndef ZSLIB_INTERNAL_USE_WIN32_EVENT
+
+      bool internalWait(const WaitTime *waitUntil);
+
+      static bool internalWaitAny(
+                                  const std::vector<zsLib::EventPtr> &events,
+                                  const WaitTime *waitUntil,
+                                  size_t &outIndex
+                                  );
+
+      static WaitTime toWaitTime(Time time);
+
+    protected:
 #ifdef ZSLIB_INTERNAL_USE_WIN32_EVENT
       HANDLE mEvent {};
 #else
@@ -59,6 +89,7 @@ namespace zsLib
       std::atomic_bool mNotified {};
       std::mutex mMutex;
       std::condition_variable mCondition;
+      AnyWaiterList mAnyWaiters;
 #endif
     };
   }
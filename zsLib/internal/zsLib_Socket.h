@@ -37,6 +37,8 @@
 #include <zsLib/Exception.h>
 #include <zsLib/Proxy.h>
 
+#include <list>
+
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2def.h>
@@ -47,6 +49,14 @@ namespace zsLib
   enum MissingSocketOptions
   {
     SO_NOSIGPIPE = -1,
+    SO_ZEROCOPY = -1,
+    MSG_ZEROCOPY = 0,
+    UDP_SEGMENT = -1,
+    UDP_GRO = -1,
+    SO_REUSEPORT = -1,
+    SO_INCOMING_CPU = -1,
+    SO_BUSY_POLL = -1,
+    SO_PREFER_BUSY_POLL = -1,
   };
 }
 
@@ -55,6 +65,7 @@ namespace zsLib
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <sys/ioctl.h>
 #ifndef FIONREAD
 #include <sys/filio.h>
@@ -77,6 +88,30 @@ namespace zsLib
 #if (defined _ANDROID || defined __QNX__ || defined _LINUX || defined __unix__)
     SO_NOSIGPIPE = -1,
 #endif //(defined _ANDROID || defined __QNX__ || defined _LINUX)
+#ifndef SO_ZEROCOPY
+    SO_ZEROCOPY = -1,
+#endif //ndef SO_ZEROCOPY
+#ifndef MSG_ZEROCOPY
+    MSG_ZEROCOPY = 0,
+#endif //ndef MSG_ZEROCOPY
+#ifndef UDP_SEGMENT
+    UDP_SEGMENT = -1,
+#endif //ndef UDP_SEGMENT
+#ifndef UDP_GRO
+    UDP_GRO = -1,
+#endif //ndef UDP_GRO
+#ifndef SO_REUSEPORT
+    SO_REUSEPORT = -1,
+#endif //ndef SO_REUSEPORT
+#ifndef SO_INCOMING_CPU
+    SO_INCOMING_CPU = -1,
+#endif //ndef SO_INCOMING_CPU
+#ifndef SO_BUSY_POLL
+    SO_BUSY_POLL = -1,
+#endif //ndef SO_BUSY_POLL
+#ifndef SO_PREFER_BUSY_POLL
+    SO_PREFER_BUSY_POLL = -1,
+#endif //ndef SO_PREFER_BUSY_POLL
 
     INVALID_SOCKET = -1,
     SOCKET_ERROR = -1,
@@ -111,6 +146,10 @@ namespace zsLib
   };
 }
 
+#ifndef _WIN32
+typedef int SOCKET;
+#endif //ndef _WIN32
+
 namespace zsLib
 {
   ZS_DECLARE_CLASS_PTR(Socket)
@@ -118,6 +157,7 @@ namespace zsLib
   namespace internal
   {
     ZS_DECLARE_CLASS_PTR(SocketMonitor)
+    ZS_DECLARE_CLASS_PTR(SocketCompletionEngine)
 
     class Socket
     {
@@ -125,7 +165,8 @@ namespace zsLib
       Socket() :
         mMonitorReadReady(true),
         mMonitorWriteReady(true),
-        mMonitorException(true)
+        mMonitorException(true),
+        mMonitorEdgeTriggered(false)
       {}
 
       Socket(const Socket &) = delete;
@@ -136,10 +177,24 @@ namespace zsLib
       void notifyReadReady();
       void notifyWriteReady();
       void notifyException();
+      void notifyIdleTimeout();
+
+      void receiveIntoPool(
+                           SocketPtr socket,
+                           ISocketDelegatePtr delegate
+                           );
+
+      bool readZeroCopyCompletions(SOCKET handle);
 
       void linkSocketMonitor();
+      void relinkSocketMonitor(SocketMonitorPtr monitor);
       void unlinkSocketMonitor();
 
+      void recordSystemCall(bool failed) const;
+      void recordReceived(size_t bytes, size_t packets = 1) const {mStatistics.mBytesReceived += bytes; mStatistics.mPacketsReceived += packets;}
+      void recordSent(size_t bytes, size_t packets = 1) const {mStatistics.mBytesSent += bytes; mStatistics.mPacketsSent += packets;}
+      void recordRearm() const {++mStatistics.mRearms;}
+
     protected:
       ISocketDelegatePtr mDelegate;
       mutable RecursiveLock mLock;
@@ -147,15 +202,51 @@ namespace zsLib
 
       SocketMonitorPtr mMonitor;
 
+      ISocketCompletionDelegatePtr mCompletionDelegate;
+      SocketCompletionEnginePtr mCompletionEngine;
+
       std::atomic<bool> mMonitorReadReady {};
       std::atomic<bool> mMonitorWriteReady {};
       std::atomic<bool> mMonitorException {};
+      std::atomic<bool> mMonitorEdgeTriggered {};
+      std::atomic<bool> mMonitorReceiveIntoPool {};
+
+      std::atomic<bool> mReceiveIntoPoolDatagrams {};
+      std::atomic<bool> mReceiveIntoPoolEnded {};     // the stream was closed thus stop receiving
+
+      std::atomic<Milliseconds::rep> mIdleTimeoutInMilliseconds {};
+
+      struct StatisticsCounters {
+        std::atomic<size_t> mBytesReceived {};
+        std::atomic<size_t> mBytesSent {};
+        std::atomic<size_t> mPacketsReceived {};
+        std::atomic<size_t> mPacketsSent {};
+        std::atomic<size_t> mSystemCalls {};
+        std::atomic<size_t> mWouldBlocks {};
+        std::atomic<size_t> mErrors {};
+        std::atomic<size_t> mReadReadyNotifications {};
+        std::atomic<size_t> mWriteReadyNotifications {};
+        std::atomic<size_t> mExceptionNotifications {};
+        std::atomic<size_t> mRearms {};
+        std::atomic<size_t> mAccepted {};
+      };
+
+      mutable StatisticsCounters mStatistics;
+
+      struct ZeroCopyCompletion {
+        ULONG mFirstSendID {};
+        ULONG mLastSendID {};
+        bool mCopied {};
+      };
+      typedef std::list<ZeroCopyCompletion> ZeroCopyCompletionList;
+
+      mutable std::atomic<bool> mZeroCopyEnabled {};
+
+      mutable Lock mZeroCopyLock;
+      ZeroCopyCompletionList mZeroCopyCompletions;
+      bool mZeroCopyCompletionsOnly {};
     };
   }
 }
 
-#ifndef _WIN32
-typedef int SOCKET;
-#endif //ndef _WIN32
-
 #endif //ZSLIB_INTERNAL_SOCKET_H_6f504f01bdd331d0c835ccae3872ce91
@@ -37,10 +37,14 @@
 #include <zsLib/Event.h>
 #include <zsLib/Log.h>
 #include <zsLib/Singleton.h>
+#include <zsLib/internal/platform.h>
 
 #include <unordered_map>
 #include <map>
 #include <set>
+#include <unordered_set>
+#include <vector>
+#include <list>
 
 #ifndef _WIN32
 #include <sys/poll.h>
@@ -48,6 +52,14 @@
 typedef size_t nfds_t;
 #endif //ndef _WIN32
 
+#ifdef HAVE_EPOLL
+#include <sys/epoll.h>
+#endif //HAVE_EPOLL
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#endif //HAVE_IO_URING
+
 namespace zsLib
 {
   ZS_DECLARE_CLASS_PTR(Socket)
@@ -56,6 +68,7 @@ namespace zsLib
   {
     ZS_DECLARE_CLASS_PTR(SocketMonitorLoadBalancer);
     ZS_DECLARE_CLASS_PTR(SocketMonitor);
+    ZS_DECLARE_CLASS_PTR(SocketCompletionEngine);
 
     //-------------------------------------------------------------------------
     //-------------------------------------------------------------------------
@@ -91,6 +104,8 @@ namespace zsLib
       typedef decltype(poll_fd::events) event_type;
 
       typedef std::map<SOCKET, poll_size> SocketIndexMap;
+      typedef std::unordered_map<SOCKET, event_type> SocketEventMap;
+      typedef std::unordered_set<SOCKET> SocketHandleSet;
 
       typedef std::pair<SocketPtr, event_type> FiredEventPair;
 
@@ -113,6 +128,21 @@ namespace zsLib
       void clear();
 
       bool isDirty() const {return mDirty;}
+      size_t getTotalRebuilds() const {return mTotalRebuilds;}
+
+      bool supportsEdgeTriggered() const;
+      void setEdgeTriggered(
+                            SOCKET socket,
+                            bool edgeTriggered
+                            );
+
+#ifdef HAVE_EPOLL
+      bool usingEpoll() const {return -1 != mEpollFD;}
+      int waitEpoll(
+                    poll_size &outSize,
+                    int timeoutInMilliseconds
+                    );
+#endif //HAVE_EPOLL
 
 #ifdef _WIN32
       void setWakeUpEvent(HANDLE handle);
@@ -132,6 +162,7 @@ namespace zsLib
                         SOCKET socket,
                         event_type events
                         );
+      void retriggerEvents(SOCKET socket);
 
     protected:
       void minOfficialAllocation(poll_size minSize);
@@ -146,6 +177,17 @@ namespace zsLib
       static long toNetworkEvents(event_type events);
 #endif //_WIN32
 
+#ifdef HAVE_EPOLL
+      void updateEpoll(
+                       SOCKET socket,
+                       event_type events
+                       );
+      void removeEpoll(SOCKET socket);
+
+      static uint32_t toEpollEvents(event_type events);
+      static event_type fromEpollEvents(uint32_t events);
+#endif //HAVE_EPOLL
+
       zsLib::Log::Params log(const char *message) const;
 
     private:
@@ -171,6 +213,18 @@ namespace zsLib
       SocketIndexMap mSocketIndexes;
 
       bool mDirty {true};
+      std::atomic<size_t> mTotalRebuilds {};                                      // polling set copied from the official set
+
+#ifdef HAVE_EPOLL
+      // when using epoll the kernel holds the official set and changes are
+      // applied immediately (even while the monitor is waiting) thus the
+      // set is never dirty
+      int mEpollFD {-1};
+      SocketEventMap mEpollSockets;
+      SocketHandleSet mEpollEdgeTriggered;
+      poll_size mEpollAllocationSize {0};
+      struct epoll_event *mEpollEvents {NULL};
+#endif //HAVE_EPOLL
     };
 
     //-------------------------------------------------------------------------
@@ -203,35 +257,77 @@ namespace zsLib
 
     public:
       ~SocketMonitor();
-      static SocketMonitorPtr link();
+      static SocketMonitorPtr link(PTRNUMBER hashValue);
+      static SocketMonitorPtr linkShard(size_t shardIndex);
+      static SocketMonitorPtr linkBusyPoll(
+                                           int cpu,
+                                           Microseconds spinTimeout
+                                           );
       void unlink();
 
+      PUID getID() const { return mID; }
+
+      static zsLib::Socket::MonitorLoadList getLoads();
+
       void monitorBegin(
                         SocketPtr socket,
                         bool monitorRead,
                         bool monitorWrite,
-                        bool monitorException
+                        bool monitorException,
+                        bool monitorEdgeTriggered = false
                         );
       void monitorEnd(zsLib::Socket &socket);
 
       void monitorRead(const zsLib::Socket &socket);
       void monitorWrite(const zsLib::Socket &socket);
       void monitorException(const zsLib::Socket &socket);
+      void retriggerRead(const zsLib::Socket &socket);
+
+      void setIdleTimeout(
+                          const zsLib::Socket &socket,
+                          Milliseconds timeout
+                          );
+
+      void setBusyPoll(
+                       int cpu,
+                       Microseconds spinTimeout
+                       );
 
       void operator()();
 
     protected:
       void shutdown();
-      PUID getID() const { return mID; }
+      size_t getTotalWaits() const { return mTotalWaits; }
+      size_t getTotalEvents() const { return mTotalEvents; }
+      size_t getTotalActiveWaits() const { return mTotalActiveWaits; }
+      size_t getMaxEventsPerWait() const { return mMaxEventsPerWait; }
+      size_t getTotalRebuilds() const { return mSocketSet.getTotalRebuilds(); }
+      size_t getTotalSpinWaits() const { return mTotalSpinWaits; }
+      size_t getTotalWakeUps() const { return mTotalWakeUps; }
+      bool isUsingEpoll() const;
+      int getBusyPollCPU() const { return mBusyPollCPU; }
+      Microseconds getThreadCPUTime();
+      Microseconds getThreadRunTime();
 
     private:
       void cancel();
 
       void processWaiting();
+      void applyRegistrations();
+      int getWaitTimeout() const;
+      bool shouldSpin() const;
+      void pinBusyPollThread();
+      void checkIdleTimeouts();
       void wakeUp();
       void createWakeUpSocket();
       void cleanWakeUpSocket();
 
+#ifndef _WIN32
+      bool createWakeUpFD();
+      bool readWakeUpFD();
+      void cleanWakeUpFD();
+#endif //ndef _WIN32
+
       zsLib::Log::Params log(const char *message) const;
       static zsLib::Log::Params slog(const char *message);
 
@@ -244,20 +340,223 @@ namespace zsLib
       ThreadPtr mThread;
       zsLib::Event mThreadReady;
       std::atomic<bool> mShouldShutdown {};
-      typedef std::unordered_map<SOCKET, SocketWeakPtr> SocketMap;
+      std::atomic<size_t> mTotalWaits {};
+      std::atomic<size_t> mTotalEvents {};
+      std::atomic<size_t> mTotalActiveWaits {};
+      std::atomic<size_t> mMaxEventsPerWait {};
+      std::atomic<size_t> mTotalSpinWaits {};
+      std::atomic<size_t> mTotalWakeUps {};
+      SteadyTime mThreadStarted {};
+
+      // a busy poll monitor waits without a timeout until no socket has fired
+      // for the spin timeout (shared threads use the longest spin timeout)
+      std::atomic<bool> mBusyPoll {};
+      int mBusyPollCPU {-1};
+      std::atomic<Microseconds::rep> mBusyPollSpinTimeout {};
+      SteadyTime mLastBusyPollActivity {};
+
+      // registrations are batched and applied by the monitor thread; an
+      // entry with a generation newer than the applied generation is still
+      // pending and is not yet part of the socket set
+      struct MonitoredSocket
+      {
+        SocketWeakPtr mSocket;
+        size_t mGeneration {};
+        event_type mPendingEvents {};
+        bool mRegistrationQueued {};                                              // the handle may be queued more than once but is applied once
+        bool mEdgeTriggered {};
+        Milliseconds mIdleTimeout {};
+        SteadyTime mLastActivity {};                                              // only maintained when an idle timeout is set
+      };
+      typedef std::unordered_map<SOCKET, MonitoredSocket> SocketMap;
+      typedef std::vector<SOCKET> SocketHandleList;
       SocketMap mMonitoredSockets;
 
+      size_t mRegistrationGeneration {};
+      size_t mAppliedGeneration {};
+      SocketHandleList mPendingRegistrations;
+
+      // sockets are only scanned for idleness once the earliest possible
+      // idle deadline passes (never if no socket has an idle timeout)
+      typedef std::vector<SocketPtr> SocketList;
+      SteadyTime mNextIdleCheck {SteadyTime::max()};
+      SocketList mIdleSockets;
+
       typedef std::list<zsLib::EventPtr> EventList;
       EventList mWaitingForRebuildList;
 
 #ifdef _WIN32
       HANDLE mWakeupEvent {};
 #else
+      // an eventfd (or a pipe) is preferred and the loopback socket is only
+      // used if neither can be created
+      int mWakeUpReadFD {-1};
+      int mWakeUpWriteFD {-1};
+      std::atomic<bool> mWakeUpPending {};
+
       IPAddress mWakeUpAddress;
       SocketPtr mWakeUpSocket;
 #endif //_WIN32
 
       SocketSet mSocketSet;
     };
+
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    #pragma mark
+    #pragma mark SocketCompletionEngine
+    #pragma mark
+
+    class SocketCompletionEngine : public ISingletonManagerDelegate
+    {
+    protected:
+      struct make_private {};
+
+    public:
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::XML::Element, Element);
+      ZS_DECLARE_TYPEDEF_PTR(zsLib::XML::Text, Text);
+
+      enum OperationTypes
+      {
+        OperationType_Receive,
+        OperationType_Send,
+        OperationType_Accept,
+      };
+
+      struct Operation
+      {
+        PUID mID {};
+        OperationTypes mType {OperationType_Receive};
+        SocketWeakPtr mSocket;            // the socket cancels its operations when closed
+        SOCKET mHandle {INVALID_SOCKET};
+        ISocketCompletionDelegatePtr mDelegate;
+        BYTE *mBuffer {};
+        size_t mBufferLengthInBytes {};
+        ULONG mFlags {};
+        bool mSubmitted {};               // handed to the kernel (io_uring only)
+        bool mPollFirst {};               // kernel reported EAGAIN thus link a poll ahead of the retry (io_uring only)
+
+        sockaddr_in6 mAddress {};         // filled in by an accept
+        socklen_t mAddressLength {};
+      };
+
+      struct Completion
+      {
+        Operation mOperation;
+        ssize_t mResult {};               // bytes transferred or the accepted handle
+        int mError {};
+      };
+
+      typedef std::unordered_map<PUID, Operation> OperationMap;
+      typedef std::list<PUID> OperationIDList;
+      typedef std::list<Completion> CompletionList;
+
+    public:
+      SocketCompletionEngine(
+                             const make_private &,
+                             bool useIOUring
+                             );
+      ~SocketCompletionEngine();
+
+      static SocketCompletionEnginePtr link();
+
+      const char *getEngineName() const;
+
+      PUID submit(Operation &operation);
+      void cancel(SOCKET handle);
+
+      void operator()();
+
+    protected:
+      static SocketCompletionEnginePtr create(bool useIOUring);
+      static SocketCompletionEnginePtr singleton(bool useIOUring);
+
+      void init();
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SocketCompletionEngine => ISingletonManagerDelegate
+      #pragma mark
+
+      virtual void notifySingletonCleanup() override;
+
+      //-----------------------------------------------------------------------
+      #pragma mark
+      #pragma mark SocketCompletionEngine => (internal)
+      #pragma mark
+
+      void cancel();
+
+      void runReadiness();
+      bool perform(
+                   Operation &operation,
+                   Completion &outCompletion
+                   );
+      void deliver(CompletionList &completions);
+
+      void wakeUp();
+      void createWakeUp();
+      void readWakeUp();
+      void cleanWakeUp();
+
+#ifdef HAVE_IO_URING
+      bool setupIOUring();
+      void cleanIOUring();
+      void runIOUring();
+      io_uring_sqe *nextSQE();
+      void stageSubmissions(bool &outMorePending);
+      void reapCompletions(CompletionList &outCompletions);
+#endif //HAVE_IO_URING
+
+      zsLib::Log::Params log(const char *message) const;
+      static zsLib::Log::Params slog(const char *message);
+
+    private:
+      AutoPUID mID;
+      RecursiveLock mLock;
+      SocketCompletionEngineWeakPtr mThisWeak;
+      SocketCompletionEnginePtr mGracefulReference;
+
+      ThreadPtr mThread;
+      zsLib::Event mThreadReady;
+      std::atomic<bool> mShouldShutdown {};
+
+      bool mUseIOUring {};                // requested by the setting
+      bool mUsingIOUring {};              // io_uring could be set up
+
+      OperationMap mOperations;
+      OperationIDList mPendingSubmissions;
+      OperationIDList mPendingCancels;
+
+      SOCKET mWakeUpHandle {INVALID_SOCKET};
+      std::atomic<bool> mWakeUpPending {};
+      SocketPtr mWakeUpSocket;            // used when an eventfd is unavailable
+
+#ifdef HAVE_IO_URING
+      int mRingFD {-1};
+      void *mSubmissionRing {};
+      size_t mSubmissionRingSize {};
+      void *mCompletionRing {};
+      size_t mCompletionRingSize {};
+      io_uring_sqe *mSubmissionEntries {};
+      size_t mSubmissionEntriesSize {};
+
+      unsigned *mSubmissionHead {};
+      unsigned *mSubmissionTail {};
+      unsigned *mSubmissionArray {};
+      unsigned mSubmissionMask {};
+      unsigned mSubmissionTotal {};
+      unsigned mSubmissionLocalTail {};
+
+      unsigned *mCompletionHead {};
+      unsigned *mCompletionTail {};
+      unsigned mCompletionMask {};
+      io_uring_cqe *mCompletionEntries {};
+
+      bool mWakeUpArmed {};
+#endif //HAVE_IO_URING
+    };
   }
 }
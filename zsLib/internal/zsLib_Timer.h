@@ -40,6 +40,8 @@ namespace zsLib
 {
   namespace internal
   {
+    ZS_DECLARE_CLASS_PTR(TimerMonitor)
+
     class Timer : public ITimer
     {
     protected:
@@ -53,7 +55,8 @@ namespace zsLib
             ITimerDelegatePtr delegate,
             Microseconds timeout,
             bool repeat,
-            size_t maxFiringTimerAtOnce
+            size_t maxFiringTimerAtOnce,
+            Microseconds tolerance
             );
 
       ~Timer();
@@ -63,12 +66,20 @@ namespace zsLib
                              ITimerDelegatePtr delegate,
                              Microseconds timeout,
                              bool repeat,
-                             size_t maxFiringTimerAtOnce
+                             size_t maxFiringTimerAtOnce,
+                             Microseconds tolerance
+                             );
+
+      static TimerPtr create(
+                             ITimerDelegatePtr delegate,
+                             Time timeout,
+                             Microseconds tolerance
                              );
 
       static TimerPtr create(
                              ITimerDelegatePtr delegate,
-                             Time timeout
+                             SteadyTime timeout,
+                             Microseconds tolerance
                              );
 
       virtual PUID getID() const override { return mID; }
@@ -78,7 +89,13 @@ namespace zsLib
       void background(bool background = true) override;  // background the timer (will run until timer is cancelled even if reference to object is forgotten)
 
     protected:
-      bool tick(const Time &time, Microseconds &sleepTime);  // returns true if should expire the timer
+      bool tick(
+                const SteadyTime &time,
+                SteadyTime &outFireNextAt,
+                IMessageQueuePtr &outQueue,
+                ITimerDelegatePtr &outDelegate,
+                size_t &outTotalFirings
+                );  // returns true if should expire the timer
 
     protected:
       RecursiveLock mLock;
@@ -86,10 +103,12 @@ namespace zsLib
       TimerWeakPtr mThisWeak;
       TimerPtr mThisBackground;
       ITimerDelegatePtr mDelegate;
+      TimerMonitorWeakPtr mMonitor;
 
       size_t mMaxFiringsAtOnce {};
-      Time mFireNextAt {};
+      SteadyTime mFireNextAt {};
       Microseconds mTimeout {};
+      Microseconds mTolerance {};
       bool mOnceOnly {};
       bool mMonitored {};
     };
@@ -34,32 +34,72 @@
 #include <condition_variable>
 
 #include <zsLib/types.h>
+#include <zsLib/ITimer.h>
 #include <zsLib/Log.h>
 #include <zsLib/IMessageQueueThread.h>
 #include <zsLib/Singleton.h>
+#include <zsLib/internal/platform.h>
 
 #include <map>
 #include <list>
+#include <vector>
 
 #ifdef __QNX__
 #include <pthread.h>
 #endif //__QNX__
 
 
-#define ZSLIB_SETTING_TIMER_MONITOR_THREAD_PRIORITY  "zsLib/timer-monitor/thread-priority"
-
 namespace zsLib
 {
   namespace internal
   {
     ZS_DECLARE_CLASS_PTR(TimerMonitor)
 
+    class TimerMonitorFiringMessage;
+
     class TimerMonitor : public ISingletonManagerDelegate
     {
     public:
+      friend class TimerMonitorFiringMessage;
+
       ZS_DECLARE_TYPEDEF_PTR(zsLib::XML::Element, Element)
       ZS_DECLARE_TYPEDEF_PTR(zsLib::XML::Text, Text)
 
+    protected:
+      // Timers are kept ordered by their next firing time so that each
+      // wake-up only visits the timers that are actually expiring. Arming
+      // and cancelling a timer are both O(log n).
+      struct ScheduledTimer
+      {
+        PUID mID {};
+        Microseconds mTolerance {};
+      };
+
+      typedef std::multimap<SteadyTime, ScheduledTimer> TimerSchedule;
+
+      struct TimerInfo
+      {
+        TimerWeakPtr mTimer;
+        Microseconds mTolerance {};
+        TimerSchedule::iterator mScheduled;
+      };
+
+      typedef std::map<PUID, TimerInfo> TimerMap;
+
+      // Timers firing in the same wake-up are grouped by the queue of their
+      // delegate and delivered as a single message per queue. The delegate
+      // is held weakly so a queued firing does not keep it alive.
+      struct TimerFiring
+      {
+        ITimerDelegateWeakPtr mDelegate;
+        TimerPtr mTimer;
+      };
+
+      typedef std::vector<TimerFiring> TimerFiringList;
+      typedef std::map<IMessageQueuePtr, TimerFiringList> QueueFiringMap;
+
+      typedef std::vector<TimerMonitorPtr> TimerMonitorList;
+
     protected:
       TimerMonitor();
       TimerMonitor(const TimerMonitor &) = delete;
@@ -72,6 +112,8 @@ namespace zsLib
       static TimerMonitorPtr singleton();
       static TimerMonitorPtr create();
 
+      static TimerMonitorPtr monitorFor(IMessageQueuePtr queue);
+
       void monitorBegin(TimerPtr timer);
       void monitorEnd(Timer &timer);
 
@@ -90,15 +132,31 @@ namespace zsLib
 
       void cancel();
 
+      void createShards(ULONG totalShards);
+
       Microseconds fireTimers();
+      void wait(Microseconds duration);
+      void deliver(QueueFiringMap &firings);
+      void schedule(
+                    PUID timerID,
+                    TimerInfo &info,
+                    const SteadyTime &fireAt
+                    );
       void wakeUp();
 
+#ifdef HAVE_TIMERFD
+      bool openTimerFD();
+      void closeTimerFD();
+      void waitTimerFD(Microseconds duration);
+#endif //HAVE_TIMERFD
+
     private:
       AutoPUID mID;
 
       RecursiveLock mLock;
       Lock mFlagLock;
       std::condition_variable mFlagNotify;
+      bool mWakeUpPending {};
 
       TimerMonitorWeakPtr mThisWeak;
       TimerMonitorPtr mGracefulShutdownReference;
@@ -106,14 +164,23 @@ namespace zsLib
       ThreadPtr mThread;
       bool mShouldShutdown;
 
-      typedef std::map<PUID, TimerWeakPtr> TimerMap;
+      TimerMonitorList mShards;
 
+      TimerSchedule mSchedule;
       TimerMap mMonitoredTimers;
+      SteadyTime mWakeUpAt {};
 
 #ifdef __QNX__
       pthread_cond_t      mCondition;
       pthread_mutex_t     mMutex;
 #endif //__QNX__
+
+#ifdef HAVE_TIMERFD
+      bool mTimerFDRequested {};
+      bool mUseTimerFD {};
+      int mTimerFD {-1};
+      int mWakeUpFD {-1};
+#endif //HAVE_TIMERFD
     };
   }
 }
@@ -55,6 +55,7 @@ namespace zsLib
   typedef std::lock_guard<RecursiveLock> AutoRecursiveLock;
 
   typedef std::chrono::system_clock::time_point Time;
+  typedef std::chrono::steady_clock::time_point SteadyTime;
   typedef std::chrono::duration<std::chrono::hours::rep, std::ratio<3600 * 24> > Days;
   typedef std::chrono::hours Hours;
   typedef std::chrono::minutes Minutes;
@@ -129,8 +130,11 @@ namespace zsLib
   ZS_DECLARE_INTERACTION_PTR(IPromiseCatchDelegate);
 
   ZS_DECLARE_INTERACTION_PTR(ISocketDelegate);
+  ZS_DECLARE_INTERACTION_PTR(ISocketCompletionDelegate);
 
   ZS_DECLARE_CLASS_PTR(Socket);
+  ZS_DECLARE_STRUCT_PTR(SocketBuffer);
+  ZS_DECLARE_CLASS_PTR(SocketShardedListener);
   ZS_DECLARE_CLASS_PTR(String);
 
   ZS_DECLARE_INTERACTION_PTR(ISettings);
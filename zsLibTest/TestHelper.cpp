@@ -31,10 +31,14 @@
 
 #include <zsLib/helpers.h>
 #include <zsLib/Stringize.h>
+#include <zsLib/Event.h>
 
 #include "testing.h"
 #include "main.h"
 
+#include <atomic>
+#include <thread>
+
 static int get99()
 {
   return 99;
@@ -115,6 +119,135 @@ namespace testing_helper
     value = 0xFFFFFFFF;
     TESTING_EQUAL(0xFFFFFFFF, value)
   }
+
+  void testClocks()
+  {
+    auto resolution = zsLib::coarseClockResolution();
+    TESTING_CHECK(resolution > zsLib::Microseconds())
+    TESTING_CHECK(resolution <= zsLib::Milliseconds(100))
+
+    // the coarse clocks are only updated by the kernel tick which can run a
+    // little late (especially when virtualized) thus allow a few ticks
+    auto maxLag = resolution * 4;
+
+    auto steadyBefore = zsLib::steadyNow();
+    auto coarseSteady = zsLib::coarseSteadyNow();
+    auto steadyAfter = zsLib::steadyNow();
+
+    TESTING_CHECK(coarseSteady <= steadyAfter)
+    TESTING_CHECK(coarseSteady + maxLag >= steadyBefore)
+
+    auto before = zsLib::now();
+    auto coarse = zsLib::coarseNow();
+    auto after = zsLib::now();
+
+    TESTING_CHECK(coarse <= after)
+    TESTING_CHECK(coarse + maxLag >= before)
+
+    auto steady = zsLib::toSteadyTime(before + zsLib::Seconds(10));
+    TESTING_CHECK(steady > steadyAfter + zsLib::Seconds(9))
+    TESTING_CHECK(steady < zsLib::steadyNow() + zsLib::Seconds(11))
+  }
+
+  void testEventWait()
+  {
+    // an event that is never notified times out
+    {
+      zsLib::EventPtr event = zsLib::Event::create();
+
+      auto before = zsLib::steadyNow();
+      TESTING_CHECK(!event->waitFor(zsLib::Milliseconds(50)))
+      TESTING_CHECK(zsLib::steadyNow() - before >= zsLib::Milliseconds(50))
+
+      before = zsLib::steadyNow();
+      TESTING_CHECK(!event->waitUntil(zsLib::now() + zsLib::Milliseconds(50)))
+      TESTING_CHECK(zsLib::steadyNow() - before >= zsLib::Milliseconds(40))    // the system clock is converted to the steady clock
+
+      // a manual reset event stays notified until reset
+      event->notify();
+      TESTING_CHECK(event->waitFor(zsLib::Milliseconds(50)))
+      TESTING_CHECK(event->waitUntil(zsLib::now() + zsLib::Milliseconds(50)))
+      event->reset();
+      TESTING_CHECK(!event->waitFor(zsLib::Milliseconds(10)))
+    }
+
+    // a successful wait consumes an auto reset event
+    {
+      zsLib::EventPtr event = zsLib::Event::create(zsLib::Event::Reset_Auto);
+
+      event->notify();
+      TESTING_CHECK(event->waitFor(zsLib::Milliseconds(50)))
+      TESTING_CHECK(!event->waitFor(zsLib::Milliseconds(10)))
+    }
+
+    // only one of many waiters consumes a single auto reset notification
+    {
+      zsLib::EventPtr event = zsLib::Event::create(zsLib::Event::Reset_Auto);
+      std::atomic<size_t> totalWoken {};
+
+      std::vector<std::thread> threads;
+      for (int index = 0; index < 4; ++index) {
+        threads.push_back(std::thread([event, &totalWoken]() {
+          if (event->waitFor(zsLib::Milliseconds(1000))) ++totalWoken;
+        }));
+      }
+
+      std::this_thread::sleep_for(zsLib::Milliseconds(100));
+      event->notify();
+
+      for (auto iter = threads.begin(); iter != threads.end(); ++iter) {
+        (*iter).join();
+      }
+
+      TESTING_EQUAL(totalWoken, 1);
+    }
+  }
+
+  void testEventWaitAny()
+  {
+    zsLib::Event::EventList events;
+    events.push_back(zsLib::Event::create(zsLib::Event::Reset_Auto));
+    events.push_back(zsLib::Event::create(zsLib::Event::Reset_Auto));
+    events.push_back(zsLib::Event::create(zsLib::Event::Reset_Manual));
+
+    // nothing notified times out
+    size_t index = 99;
+    auto before = zsLib::steadyNow();
+    TESTING_CHECK(!zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(50), &index))
+    TESTING_CHECK(zsLib::steadyNow() - before >= zsLib::Milliseconds(50))
+    TESTING_EQUAL(index, 99);
+    TESTING_CHECK(!zsLib::Event::waitAnyUntil(events, zsLib::now() + zsLib::Milliseconds(20), &index))
+
+    // the index of the notified event is returned
+    events[1]->notify();
+    index = zsLib::Event::waitAny(events);
+    TESTING_EQUAL(index, 1);
+    TESTING_CHECK(!zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(10)))    // consumed by the wait
+
+    // events notified together are returned one at a time
+    events[0]->notify();
+    events[1]->notify();
+    size_t first = 99;
+    size_t second = 99;
+    TESTING_CHECK(zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(50), &first))
+    TESTING_CHECK(zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(50), &second))
+    TESTING_CHECK(first != second)
+    TESTING_CHECK((first < 2) && (second < 2))
+    TESTING_CHECK(!zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(10)))
+
+    // a notification from another thread wakes the waiter
+    std::thread thread([&events]() {
+      std::this_thread::sleep_for(zsLib::Milliseconds(50));
+      events[2]->notify();
+    });
+    TESTING_CHECK(zsLib::Event::waitAnyFor(events, zsLib::Milliseconds(1000), &index))
+    TESTING_EQUAL(index, 2);
+    thread.join();
+
+    // a manual reset event is not consumed
+    index = zsLib::Event::waitAny(events);
+    TESTING_EQUAL(index, 2);
+  }
 }
 
 void testHelper()
@@ -125,4 +258,7 @@ void testHelper()
   testing_helper::testPuidGuid();
   testing_helper::testAtomicIncDec();
   testing_helper::testAtomicGetSet();
+  testing_helper::testClocks();
+  testing_helper::testEventWait();
+  testing_helper::testEventWaitAny();
 }
@@ -36,6 +36,11 @@
 #include "testing.h"
 #include "main.h"
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif //ndef _WIN32
+
 #define HlZeroStruct(xValue) memset(&(xValue), 0, sizeof(xValue))
 #define HlZeroMemory(xValue, xSize) memset((xValue), 0, xSize)
 
@@ -133,6 +138,134 @@ public:
       TESTING_CHECK(address1 == getaddress1)
       TESTING_CHECK(address2 == getaddress2)
     }
+    {
+      zsLib::SocketPtr socket1 = zsLib::Socket::createUDP();
+      socket1->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      zsLib::SocketPtr socket2 = zsLib::Socket::createUDP();
+      socket2->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket2->setBlocking(false);
+
+      zsLib::IPAddress address1 = socket1->getLocalAddress();
+      zsLib::IPAddress address2 = socket2->getLocalAddress();
+
+      BYTE sendBuffers[10][16];
+      zsLib::Socket::DatagramBuffer sendDatagrams[10];
+      for (size_t index = 0; index < 10; ++index) {
+        HlZeroMemory(&(sendBuffers[index][0]), sizeof(sendBuffers[index]));
+        sendBuffers[index][0] = static_cast<BYTE>(index);
+        sendDatagrams[index].mAddress = address2;
+        sendDatagrams[index].mBuffer = &(sendBuffers[index][0]);
+        sendDatagrams[index].mBufferLengthInBytes = index + 1;
+      }
+
+      bool wouldBlock = false;
+      size_t sent = socket1->sendToBatch(&(sendDatagrams[0]), 10, &wouldBlock);
+      TESTING_EQUAL(sent, 10)
+      TESTING_CHECK(!wouldBlock)
+      TESTING_EQUAL(sendDatagrams[9].mLengthInBytes, 10)
+
+      BYTE receiveBuffers[16][16];
+      zsLib::Socket::DatagramBuffer receiveDatagrams[16];
+      for (size_t index = 0; index < 16; ++index) {
+        receiveDatagrams[index].mBuffer = &(receiveBuffers[index][0]);
+        receiveDatagrams[index].mBufferLengthInBytes = sizeof(receiveBuffers[index]);
+      }
+
+      size_t received = socket2->receiveFromBatch(&(receiveDatagrams[0]), 16, &wouldBlock);
+      TESTING_EQUAL(received, 10)
+      for (size_t index = 0; index < received; ++index) {
+        TESTING_EQUAL(receiveDatagrams[index].mLengthInBytes, index + 1)
+        TESTING_EQUAL(receiveDatagrams[index].mBuffer[0], static_cast<BYTE>(index))
+        TESTING_EQUAL(receiveDatagrams[index].mError, 0)
+        TESTING_CHECK(address1 == receiveDatagrams[index].mAddress)
+      }
+
+      received = socket2->receiveFromBatch(&(receiveDatagrams[0]), 16, &wouldBlock);
+      TESTING_EQUAL(received, 0)
+      TESTING_CHECK(wouldBlock)
+    }
+    {
+      zsLib::SocketPtr socket1 = zsLib::Socket::createUDP();
+      socket1->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      zsLib::SocketPtr socket2 = zsLib::Socket::createUDP();
+      socket2->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      zsLib::IPAddress address2 = socket2->getLocalAddress();
+
+      BYTE buffer[3] {1, 2, 3};
+      for (size_t index = 0; index < 3; ++index) {
+        size_t sent = socket1->sendTo(address2, &(buffer[index]), 1);
+        TESTING_EQUAL(sent, 1)
+      }
+
+      BYTE receiveBuffers[16][16];
+      zsLib::Socket::DatagramBuffer receiveDatagrams[16];
+      for (size_t index = 0; index < 16; ++index) {
+        receiveDatagrams[index].mBuffer = &(receiveBuffers[index][0]);
+        receiveDatagrams[index].mBufferLengthInBytes = sizeof(receiveBuffers[index]);
+      }
+
+      // a blocking socket must return what is pending rather than wait for a full batch
+      bool wouldBlock = false;
+      size_t received = socket2->receiveFromBatch(&(receiveDatagrams[0]), 16, &wouldBlock);
+      TESTING_EQUAL(received, 3)
+      TESTING_EQUAL(receiveDatagrams[2].mBuffer[0], 3)
+    }
+    {
+      zsLib::SocketPtr socket1 = zsLib::Socket::createUDP();
+      socket1->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      zsLib::SocketPtr socket2 = zsLib::Socket::createUDP();
+      socket2->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket2->setBlocking(false);
+
+      try {
+        socket1->setOptionValue(zsLib::Socket::SetOptionValue::UDPSegmentSizeInBytes, 100);
+        TESTING_EQUAL(socket1->getOptionValue(zsLib::Socket::GetOptionValue::UDPSegmentSizeInBytes), 100)
+        socket1->setOptionValue(zsLib::Socket::SetOptionValue::UDPSegmentSizeInBytes, 0);
+
+        socket2->setOptionFlag(zsLib::Socket::SetOptionFlag::UDPReceiveCoalescing, true);
+        TESTING_CHECK(socket2->getOptionFlag(zsLib::Socket::GetOptionFlag::IsUDPReceiveCoalescing))
+      } catch (zsLib::Socket::Exceptions::UnsupportedSocketOption &) {
+        TESTING_STDOUT() << "UDP SEGMENTATION OFFLOAD NOT SUPPORTED\n";
+      }
+
+      BYTE sendBuffer[950];
+      for (size_t index = 0; index < sizeof(sendBuffer); ++index) {
+        sendBuffer[index] = static_cast<BYTE>(index / 100);
+      }
+
+      TESTING_EQUAL(zsLib::Socket::getTotalSegments(sizeof(sendBuffer), 100), 10)
+
+      size_t sent = socket1->sendToSegmented(socket2->getLocalAddress(), &(sendBuffer[0]), sizeof(sendBuffer), 100);
+      TESTING_EQUAL(sent, sizeof(sendBuffer))
+
+      // segments may arrive coalesced or one at a time but always in order
+      BYTE receiveBuffer[0x10000];
+      size_t totalSegments = 0;
+      size_t totalReceived = 0;
+      while (true) {
+        zsLib::IPAddress remoteIP;
+        size_t segmentSize = 0;
+        bool wouldBlock = false;
+        size_t received = socket2->receiveFromCoalesced(remoteIP, &(receiveBuffer[0]), sizeof(receiveBuffer), segmentSize, &wouldBlock);
+        if (wouldBlock) break;
+
+        zsLib::Socket::BufferSpan segments[64];
+        size_t total = zsLib::Socket::splitSegments(&(receiveBuffer[0]), received, segmentSize, &(segments[0]), 64);
+        TESTING_EQUAL(total, zsLib::Socket::getTotalSegments(received, segmentSize))
+        for (size_t index = 0; index < total; ++index, ++totalSegments) {
+          TESTING_EQUAL(segments[index].mLengthInBytes, (9 == totalSegments ? 50 : 100))
+          TESTING_EQUAL(segments[index].mBuffer[0], static_cast<BYTE>(totalSegments))
+        }
+        totalReceived += received;
+      }
+
+      TESTING_EQUAL(totalSegments, 10)
+      TESTING_EQUAL(totalReceived, sizeof(sendBuffer))
+    }
     {
       zsLib::IPAddress address1(zsLib::IPAddress::loopbackV6(), port1);
       zsLib::IPAddress address2(zsLib::IPAddress::loopbackV6(), port2);
@@ -156,6 +289,45 @@ public:
       TESTING_CHECK(sizeof("HELLO") == length)
       TESTING_CHECK(0 == memcmp(&(buffer[0]), "HELLO", sizeof("HELLO")))
 
+      BYTE header[] = {'H', 'E'};
+      BYTE body[] = {'L', 'L', 'O', 0};
+      zsLib::Socket::BufferSpan sendSpans[2];
+      sendSpans[0].mBuffer = &(header[0]);
+      sendSpans[0].mLengthInBytes = sizeof(header);
+      sendSpans[1].mBuffer = &(body[0]);
+      sendSpans[1].mLengthInBytes = sizeof(body);
+      length = socket3->sendVectored(&(sendSpans[0]), 2);
+      TESTING_CHECK(sizeof("HELLO") == length)
+
+      BYTE first[3];
+      BYTE second[16];
+      HlZeroMemory(&(second[0]), sizeof(second));
+      zsLib::Socket::BufferSpan receiveSpans[2];
+      receiveSpans[0].mBuffer = &(first[0]);
+      receiveSpans[0].mLengthInBytes = sizeof(first);
+      receiveSpans[1].mBuffer = &(second[0]);
+      receiveSpans[1].mLengthInBytes = sizeof(second);
+      length = socket2->receiveVectored(&(receiveSpans[0]), 2);
+      TESTING_CHECK(sizeof("HELLO") == length)
+      TESTING_CHECK(0 == memcmp(&(first[0]), "HEL", sizeof(first)))
+      TESTING_CHECK(0 == memcmp(&(second[0]), "LO", sizeof("LO")))
+
+      FILE *file = tmpfile();
+      TESTING_CHECK(NULL != file)
+      if (file) {
+        fwrite("XXHELLO", 1, sizeof("XXHELLO"), file);
+        fflush(file);
+
+        length = socket3->sendFile(fileno(file), 2, sizeof("HELLO"));
+        TESTING_CHECK(sizeof("HELLO") == length)
+
+        HlZeroMemory(&(buffer[0]), sizeof(buffer));
+        length = socket2->receive(buffer, sizeof(buffer));
+        TESTING_CHECK(sizeof("HELLO") == length)
+        TESTING_CHECK(0 == memcmp(&(buffer[0]), "HELLO", sizeof("HELLO")))
+        fclose(file);
+      }
+
       zsLib::IPAddress getaddress1 = socket1->getLocalAddress();
       zsLib::IPAddress getaddress2 = socket2->getLocalAddress();
       zsLib::IPAddress getaddress3 = socket3->getLocalAddress();
@@ -170,6 +342,191 @@ public:
       TESTING_CHECK(getaddress3 == remoteaddress2)
       TESTING_CHECK(address1 == remoteaddress2)
     }
+    {
+      zsLib::SocketShardedListenerPtr listener = zsLib::SocketShardedListener::create(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0), 2);
+      TESTING_EQUAL(listener->getTotalShards(), 2)
+      TESTING_CHECK(listener->getShard(0)->getOptionFlag(zsLib::Socket::GetOptionFlag::IsReusePort))
+      TESTING_CHECK(listener->getShard(0)->getLocalAddress() == listener->getShard(1)->getLocalAddress())
+
+      std::vector<zsLib::SocketPtr> clients;
+      for (size_t index = 0; index < 8; ++index) {
+        zsLib::SocketPtr client = zsLib::Socket::createTCP();
+        client->connect(listener->getLocalAddress());
+        clients.push_back(client);
+      }
+
+      // every connection is accepted by exactly one of the shards
+      for (size_t index = 0; index < listener->getTotalShards(); ++index) {
+        while (true) {
+          zsLib::IPAddress remoteIP;
+          bool wouldBlock = false;
+          zsLib::SocketPtr accepted = listener->getShard(index)->accept(remoteIP, &wouldBlock);
+          if (!accepted) break;
+        }
+      }
+
+      TESTING_EQUAL(listener->getTotalAccepted(), 8)
+
+      zsLib::SocketShardedListener::ShardList shards = listener->getShards();
+      TESTING_EQUAL(shards.size(), 2)
+      TESTING_CHECK(shards.front().mMonitorID != shards.back().mMonitorID)
+      TESTING_EQUAL(shards.front().mTotalAccepted + shards.back().mTotalAccepted, 8)
+      TESTING_EQUAL(shards.front().mIncomingCPU, -1)
+
+      listener->close();
+    }
+    {
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+      listener->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+
+      std::vector<zsLib::SocketPtr> clients;
+      for (size_t index = 0; index < 4; ++index) {
+        zsLib::SocketPtr client = zsLib::Socket::createTCP();
+        client->connect(listener->getLocalAddress());
+        clients.push_back(client);
+      }
+
+      zsLib::Socket::AcceptOptions options;
+      options.mTCPNoDelay = true;
+
+      zsLib::Socket::AcceptedSocketList accepted;
+      bool wouldBlock = false;
+      size_t total = listener->acceptBatch(accepted, &options, 0, &wouldBlock);
+      TESTING_EQUAL(total, 4)
+      TESTING_EQUAL(accepted.size(), 4)
+      TESTING_CHECK(wouldBlock)
+
+      for (auto iter = accepted.begin(); iter != accepted.end(); ++iter) {
+        auto &socket = (*iter).mSocket;
+        TESTING_CHECK((*iter).mRemoteIP.isLoopback())
+        TESTING_CHECK(socket->getOptionFlag(zsLib::Socket::GetOptionFlag::IsTCPNoDelay))
+
+        BYTE buffer[16];
+        bool receiveWouldBlock = false;
+        socket->receive(buffer, sizeof(buffer), &receiveWouldBlock);
+        TESTING_CHECK(receiveWouldBlock)                         // accepted as non-blocking
+      }
+
+      // a limited batch leaves the remaining connections pending
+      for (size_t index = 0; index < 3; ++index) {
+        zsLib::SocketPtr client = zsLib::Socket::createTCP();
+        client->connect(listener->getLocalAddress());
+        clients.push_back(client);
+      }
+
+      accepted.clear();
+      total = listener->acceptBatch(accepted, NULL, 2, &wouldBlock);
+      TESTING_EQUAL(total, 2)
+      TESTING_CHECK(!wouldBlock)
+      total = listener->acceptBatch(accepted, NULL, 0, &wouldBlock);
+      TESTING_EQUAL(total, 1)
+      TESTING_EQUAL(accepted.size(), 3)
+
+      TESTING_EQUAL(listener->getStatistics().mAccepted, 7)
+    }
+    {
+      // a blocking listener must not wait for connections beyond the first
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+
+      std::vector<zsLib::SocketPtr> clients;
+      for (size_t index = 0; index < 2; ++index) {
+        zsLib::SocketPtr client = zsLib::Socket::createTCP();
+        client->connect(listener->getLocalAddress());
+        clients.push_back(client);
+      }
+
+      zsLib::Socket::AcceptedSocketList accepted;
+      size_t total = listener->acceptBatch(accepted);
+      TESTING_EQUAL(total, 1)
+      total = listener->acceptBatch(accepted);
+      TESTING_EQUAL(total, 1)
+      TESTING_EQUAL(accepted.size(), 2)
+
+      listener->close();
+    }
+#ifndef _WIN32
+    {
+      // an error after some connections were accepted returns the batch
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+      listener->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+
+      std::vector<zsLib::SocketPtr> clients;
+      for (size_t index = 0; index < 2; ++index) {
+        zsLib::SocketPtr client = zsLib::Socket::createTCP();
+        client->connect(listener->getLocalAddress());
+        clients.push_back(client);
+      }
+
+      // only the lowest free descriptor can be allocated thus the second
+      // accept fails with EMFILE
+      int freeDescriptor = dup(0);
+      close(freeDescriptor);
+
+      struct rlimit original {};
+      getrlimit(RLIMIT_NOFILE, &original);
+      struct rlimit limit = original;
+      limit.rlim_cur = static_cast<rlim_t>(freeDescriptor + 1);
+      setrlimit(RLIMIT_NOFILE, &limit);
+
+      zsLib::Socket::AcceptedSocketList accepted;
+      bool wouldBlock = false;
+      int error = 0;
+      size_t total = listener->acceptBatch(accepted, NULL, 0, &wouldBlock, &error);
+
+      setrlimit(RLIMIT_NOFILE, &original);
+
+      TESTING_EQUAL(total, 1)
+      TESTING_EQUAL(accepted.size(), 1)
+      TESTING_EQUAL(error, EMFILE)
+
+      total = listener->acceptBatch(accepted);
+      TESTING_EQUAL(total, 1)
+      TESTING_EQUAL(accepted.size(), 2)
+
+      listener->close();
+    }
+#endif //ndef _WIN32
+    {
+      zsLib::SocketPtr socket1 = zsLib::Socket::createUDP();
+      socket1->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      zsLib::SocketPtr socket2 = zsLib::Socket::createUDP();
+      socket2->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket2->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+
+      for (size_t index = 0; index < 3; ++index) {
+        socket1->sendTo(socket2->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+      TESTING_SLEEP(100)
+
+      BYTE buffer[1024];
+      zsLib::IPAddress remoteIP;
+      bool wouldBlock = false;
+      size_t received = 0;
+      do {
+        received = socket2->receiveFrom(remoteIP, buffer, sizeof(buffer), &wouldBlock);
+      } while (!wouldBlock);
+
+      zsLib::Socket::Statistics sent = socket1->getStatistics();
+      TESTING_EQUAL(sent.mPacketsSent, 3)
+      TESTING_EQUAL(sent.mBytesSent, 3 * sizeof("HELLO"))
+      TESTING_EQUAL(sent.mSystemCalls, 3)
+      TESTING_EQUAL(sent.mErrors, 0)
+
+      zsLib::Socket::Statistics stats = socket2->getStatistics();
+      TESTING_EQUAL(stats.mPacketsReceived, 3)
+      TESTING_EQUAL(stats.mBytesReceived, 3 * sizeof("HELLO"))
+      TESTING_EQUAL(stats.mSystemCalls, 4)
+      TESTING_EQUAL(stats.mWouldBlocks, 1)
+      TESTING_EQUAL(stats.mErrors, 0)
+      TESTING_EQUAL(received, 0)
+    }
 
     {int i = 0; ++i;}
   }
@@ -32,12 +32,22 @@
 #include <zsLib/Socket.h>
 #include <zsLib/IPAddress.h>
 #include <zsLib/IMessageQueueThread.h>
+#include <zsLib/ISettings.h>
 
 
 #include "testing.h"
 #include "main.h"
 
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif //ndef _WIN32
+
+#define ZSLIB_TEST_SOCKET_BENCHMARK_TOTAL_READY (1000)
 
 using zsLib::BYTE;
 using zsLib::ULONG;
@@ -134,6 +144,7 @@ namespace async_socket
       mAddress = zsLib::IPAddress(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 43218));
       mSocket = zsLib::Socket::createTCP();
       mSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      mSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::ReuseAddress, true);
       mSocket->bind(mAddress);
       mSocket->listen();
       mSocket->setDelegate(mThis.lock());
@@ -199,6 +210,1104 @@ namespace async_socket
     zsLib::IPAddress mAddressIncoming;
   };
 
+  ZS_DECLARE_CLASS_PTR(BenchmarkSocket)
+
+  class BenchmarkSocket : public zsLib::MessageQueueAssociator,
+                          public zsLib::ISocketDelegate
+  {
+  private:
+    BenchmarkSocket(zsLib::IMessageQueuePtr queue) : zsLib::MessageQueueAssociator(queue) { }
+
+  public:
+    static BenchmarkSocketPtr create(zsLib::IMessageQueuePtr queue)
+    {
+      BenchmarkSocketPtr object(new BenchmarkSocket(queue));
+      object->mThis = object;
+      return object;
+    }
+
+    virtual void onReadReady(zsLib::SocketPtr socket)
+    {
+      zsLib::IPAddress address;
+      BYTE buffer[64];
+      bool wouldBlock = false;
+      socket->receiveFrom(address, buffer, sizeof(buffer), &wouldBlock);
+      ++mReadReadyCalled;
+    }
+
+    virtual void onWriteReady(zsLib::SocketPtr socket) {}
+    virtual void onException(zsLib::SocketPtr socket) {}
+
+  public:
+    std::atomic<size_t> mReadReadyCalled {};
+
+  private:
+    BenchmarkSocketWeakPtr mThis;
+  };
+
+  ZS_DECLARE_CLASS_PTR(DrainingSocket)
+
+  class DrainingSocket : public zsLib::MessageQueueAssociator,
+                         public zsLib::ISocketDelegate
+  {
+  private:
+    DrainingSocket(zsLib::IMessageQueuePtr queue) : zsLib::MessageQueueAssociator(queue) { }
+
+  public:
+    static DrainingSocketPtr create(zsLib::IMessageQueuePtr queue)
+    {
+      DrainingSocketPtr object(new DrainingSocket(queue));
+      object->mThis = object;
+      return object;
+    }
+
+    virtual void onReadReady(zsLib::SocketPtr socket)
+    {
+      ++mReadReadyCalled;
+
+      // edge triggered sockets must be drained until they would block
+      while (true) {
+        zsLib::IPAddress address;
+        BYTE buffer[64];
+        bool wouldBlock = false;
+        int error = 0;
+        size_t length = socket->receiveFrom(address, buffer, sizeof(buffer), &wouldBlock, zsLib::Socket::Receive::None, &error);
+        if ((wouldBlock) || (0 != error) || (0 == length)) break;
+        ++mTotalReceived;
+      }
+    }
+
+    virtual void onWriteReady(zsLib::SocketPtr socket) {++mWriteReadyCalled;}
+    virtual void onException(zsLib::SocketPtr socket) {++mExceptionCalled;}
+
+    virtual void onZeroCopyCompleted(
+                                     zsLib::SocketPtr socket,
+                                     zsLib::ULONG firstSendID,
+                                     zsLib::ULONG lastSendID,
+                                     bool copied
+                                     )
+    {
+      mTotalZeroCopyCompleted += (lastSendID - firstSendID + 1);
+    }
+
+    virtual void onDataReceived(
+                                zsLib::SocketPtr socket,
+                                zsLib::SocketBufferPtr buffer
+                                )
+    {
+      if (0 == buffer->mLengthInBytes) {++mTotalPooledEnded; return;}
+      TESTING_CHECK(buffer->mCapacityInBytes >= buffer->mLengthInBytes);
+      ++mTotalPooledReceived;
+      mTotalPooledBytes += buffer->mLengthInBytes;
+    }
+
+    virtual void onIdleTimeout(zsLib::SocketPtr socket) {++mIdleTimeoutCalled;}
+
+  public:
+    std::atomic<size_t> mReadReadyCalled {};
+    std::atomic<size_t> mWriteReadyCalled {};
+    std::atomic<size_t> mExceptionCalled {};
+    std::atomic<size_t> mTotalReceived {};
+    std::atomic<size_t> mTotalZeroCopyCompleted {};
+    std::atomic<size_t> mTotalPooledReceived {};
+    std::atomic<size_t> mTotalPooledBytes {};
+    std::atomic<size_t> mTotalPooledEnded {};
+    std::atomic<size_t> mIdleTimeoutCalled {};
+
+  private:
+    DrainingSocketWeakPtr mThis;
+  };
+
+  ZS_DECLARE_CLASS_PTR(DirectSocket)
+
+  class DirectSocket : public zsLib::ISocketDelegate
+  {
+  public:
+    virtual void onReadReady(zsLib::SocketPtr socket)
+    {
+      if (std::this_thread::get_id() == mTestThreadID) ++mCalledFromTestThread;
+
+      zsLib::IPAddress address;
+      BYTE buffer[64];
+      bool wouldBlock = false;
+      size_t length = socket->receiveFrom(address, buffer, sizeof(buffer), &wouldBlock);
+      if ((!wouldBlock) && (0 != length)) ++mTotalReceived;
+    }
+
+    virtual void onWriteReady(zsLib::SocketPtr socket) {}
+    virtual void onException(zsLib::SocketPtr socket) {}
+
+  public:
+    std::thread::id mTestThreadID {std::this_thread::get_id()};
+    std::atomic<size_t> mCalledFromTestThread {};
+    std::atomic<size_t> mTotalReceived {};
+  };
+
+  ZS_DECLARE_CLASS_PTR(MisbehavingSocket)
+
+  // either throws from its handler or releases the last reference to its
+  // socket from within the handler
+  class MisbehavingSocket : public zsLib::ISocketDelegate
+  {
+  public:
+    virtual void onReadReady(zsLib::SocketPtr socket)
+    {
+      zsLib::IPAddress address;
+      BYTE buffer[64];
+      bool wouldBlock = false;
+      socket->receiveFrom(address, buffer, sizeof(buffer), &wouldBlock);
+
+      ++mTotalCalled;
+      if (mThrow) throw std::runtime_error("misbehaving socket delegate");
+
+      mSocket.reset();
+    }
+
+    virtual void onWriteReady(zsLib::SocketPtr socket) {}
+    virtual void onException(zsLib::SocketPtr socket) {}
+
+  public:
+    bool mThrow {};
+    zsLib::SocketPtr mSocket;
+    std::atomic<size_t> mTotalCalled {};
+  };
+
+  ZS_DECLARE_CLASS_PTR(StallingSocket)
+
+  // holds the monitor thread inside a notification so registrations made
+  // meanwhile stay pending
+  class StallingSocket : public zsLib::ISocketDelegate
+  {
+  public:
+    virtual void onReadReady(zsLib::SocketPtr socket)
+    {
+      zsLib::IPAddress address;
+      BYTE buffer[64];
+      bool wouldBlock = false;
+      socket->receiveFrom(address, buffer, sizeof(buffer), &wouldBlock);
+
+      mStalled = true;
+      while (!mRelease) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    virtual void onWriteReady(zsLib::SocketPtr socket) {}
+    virtual void onException(zsLib::SocketPtr socket) {}
+
+  public:
+    std::atomic<bool> mStalled {};
+    std::atomic<bool> mRelease {};
+  };
+
+  ZS_DECLARE_CLASS_PTR(CompletionSocket)
+
+  class CompletionSocket : public zsLib::MessageQueueAssociator,
+                           public zsLib::ISocketCompletionDelegate
+  {
+  private:
+    CompletionSocket(zsLib::IMessageQueuePtr queue) : zsLib::MessageQueueAssociator(queue) { }
+
+  public:
+    static CompletionSocketPtr create(zsLib::IMessageQueuePtr queue)
+    {
+      CompletionSocketPtr object(new CompletionSocket(queue));
+      object->mThis = object;
+      return object;
+    }
+
+    virtual void onSocketReceiveCompleted(
+                                          zsLib::SocketPtr socket,
+                                          zsLib::PUID operationID,
+                                          BYTE *buffer,
+                                          size_t bytesReceived,
+                                          int error
+                                          )
+    {
+      if (0 != error) {++mErrors; return;}
+      mBytesReceived += bytesReceived;
+      ++mReceived;
+    }
+
+    virtual void onSocketSendCompleted(
+                                       zsLib::SocketPtr socket,
+                                       zsLib::PUID operationID,
+                                       const BYTE *buffer,
+                                       size_t bytesSent,
+                                       int error
+                                       )
+    {
+      if (0 != error) {++mErrors; return;}
+      mBytesSent += bytesSent;
+    }
+
+    virtual void onSocketAcceptCompleted(
+                                         zsLib::SocketPtr socket,
+                                         zsLib::PUID operationID,
+                                         zsLib::SocketPtr acceptedSocket,
+                                         zsLib::IPAddress remoteIP,
+                                         int error
+                                         )
+    {
+      if (0 != error) {++mErrors; return;}
+      mAcceptedSocket = acceptedSocket;
+      ++mAccepted;
+    }
+
+  public:
+    std::atomic<size_t> mReceived {};
+    std::atomic<size_t> mBytesReceived {};
+    std::atomic<size_t> mBytesSent {};
+    std::atomic<size_t> mAccepted {};
+    std::atomic<size_t> mErrors {};
+    zsLib::SocketPtr mAcceptedSocket;
+
+  private:
+    CompletionSocketWeakPtr mThis;
+  };
+
+  //---------------------------------------------------------------------------
+  static void testEdgeTriggered(bool useEpoll)
+  {
+    zsLib::ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL, useEpoll);
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      DrainingSocketPtr delegate = DrainingSocket::create(thread);
+
+      zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+      socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket->monitor(zsLib::Socket::Monitor::Options(zsLib::Socket::Monitor::All | zsLib::Socket::Monitor::EdgeTriggered));
+      socket->setDelegate(delegate);
+
+      zsLib::IPAddress address = socket->getLocalAddress();
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+
+      for (size_t index = 0; index < 5; ++index) {
+        sender->sendTo(address, (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mTotalReceived, 5);
+      TESTING_CHECK(delegate->mWriteReadyCalled > 0);                // epoll may re-report writability along with new read edges
+      TESTING_CHECK(delegate->mReadReadyCalled > 0);
+
+      size_t readReadyCalled = delegate->mReadReadyCalled;
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mReadReadyCalled, readReadyCalled);   // not notified again until new data arrives
+
+      for (size_t index = 0; index < 2; ++index) {
+        sender->sendTo(address, (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mTotalReceived, 7);
+      TESTING_CHECK(delegate->mReadReadyCalled > readReadyCalled);
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL);
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void testZeroCopy()
+  {
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      DrainingSocketPtr delegate = DrainingSocket::create(thread);
+
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->setOptionFlag(zsLib::Socket::SetOptionFlag::ReuseAddress, true);
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+
+      zsLib::SocketPtr sender = zsLib::Socket::createTCP();
+      sender->connect(listener->getLocalAddress());
+
+      zsLib::IPAddress remoteIP;
+      zsLib::SocketPtr receiver = listener->accept(remoteIP);
+      TESTING_CHECK(receiver)
+
+      sender->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      sender->setOptionFlag(zsLib::Socket::SetOptionFlag::ZeroCopy, true);
+      sender->setDelegate(delegate);
+
+      BYTE buffer[1024] {};
+      for (size_t index = 0; index < 3; ++index) {
+        sender->send(buffer, sizeof(buffer), NULL, zsLib::Socket::Send::ZeroCopy);
+      }
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mTotalZeroCopyCompleted, 3);
+      TESTING_EQUAL(delegate->mExceptionCalled, 0);
+
+      // completions must not stop the socket from being monitored
+      size_t readReadyCalled = delegate->mReadReadyCalled;
+      receiver->send((BYTE *)"HELLO", sizeof("HELLO"));
+
+      TESTING_SLEEP(500)
+
+      TESTING_CHECK(delegate->mReadReadyCalled > readReadyCalled);
+      TESTING_EQUAL(delegate->mTotalReceived, 1);
+    }
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void testReceiveIntoPool()
+  {
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      DrainingSocketPtr delegate = DrainingSocket::create(thread);
+
+      zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+      socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket->monitor(zsLib::Socket::Monitor::Options(zsLib::Socket::Monitor::All | zsLib::Socket::Monitor::ReceiveIntoPool));
+      socket->setDelegate(delegate);
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      for (size_t index = 0; index < 5; ++index) {
+        sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mTotalPooledReceived, 5);
+      TESTING_EQUAL(delegate->mTotalPooledBytes, 5 * sizeof("HELLO"));
+      TESTING_EQUAL(delegate->mReadReadyCalled, 0);                 // data was delivered instead of read readiness
+
+      // a closed stream delivers a single empty buffer
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->setOptionFlag(zsLib::Socket::SetOptionFlag::ReuseAddress, true);
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+
+      zsLib::SocketPtr client = zsLib::Socket::createTCP();
+      client->connect(listener->getLocalAddress());
+
+      zsLib::IPAddress remoteIP;
+      zsLib::SocketPtr receiver = listener->accept(remoteIP);
+      TESTING_CHECK(receiver)
+
+      receiver->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      receiver->monitor(zsLib::Socket::Monitor::Options(zsLib::Socket::Monitor::Read | zsLib::Socket::Monitor::ReceiveIntoPool));
+      receiver->setDelegate(delegate);
+
+      client->send((BYTE *)"HELLO", sizeof("HELLO"));
+      TESTING_SLEEP(500)
+      client->close();
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mTotalPooledReceived, 6);
+      TESTING_EQUAL(delegate->mTotalPooledEnded, 1);
+      TESTING_EQUAL(delegate->mReadReadyCalled, 0);
+
+      // an edge triggered socket with more pending than is read per
+      // notification must be reported again until it is drained
+      zsLib::SocketPtr edgeSocket = zsLib::Socket::createUDP();
+      edgeSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      edgeSocket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      for (size_t index = 0; index < 50; ++index) {
+        sender->sendTo(edgeSocket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      edgeSocket->monitor(zsLib::Socket::Monitor::Options(zsLib::Socket::Monitor::Read | zsLib::Socket::Monitor::EdgeTriggered | zsLib::Socket::Monitor::ReceiveIntoPool));
+      edgeSocket->setDelegate(delegate);
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mTotalPooledReceived, 56);
+      TESTING_CHECK(edgeSocket->getStatistics().mRearms > 0)
+
+      edgeSocket->close();
+    }
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void testDirectDelegate()
+  {
+    zsLib::ISettings::setUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS, 1);     // every socket shares one monitor thread
+
+    DirectSocketPtr delegate = std::make_shared<DirectSocket>();
+
+    zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+    socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+    socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+    socket->monitor(zsLib::Socket::Monitor::Read);
+    socket->setDirectDelegate(delegate);
+
+    zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+    for (size_t index = 0; index < 5; ++index) {
+      sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    }
+
+    TESTING_SLEEP(1000)
+
+    TESTING_EQUAL(delegate->mTotalReceived, 5);
+    TESTING_EQUAL(delegate->mCalledFromTestThread, 0);
+
+    // a throwing direct delegate is treated as gone and the monitor thread
+    // keeps serving its other sockets
+    MisbehavingSocketPtr throwing = std::make_shared<MisbehavingSocket>();
+    throwing->mThrow = true;
+
+    zsLib::SocketPtr throwingSocket = zsLib::Socket::createUDP();
+    throwingSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+    throwingSocket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+    throwingSocket->monitor(zsLib::Socket::Monitor::Read);
+    throwingSocket->setDirectDelegate(throwing);
+
+    for (size_t index = 0; index < 2; ++index) {
+      sender->sendTo(throwingSocket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      TESTING_SLEEP(200)
+    }
+    TESTING_EQUAL(throwing->mTotalCalled, 1);
+
+    sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    TESTING_SLEEP(200)
+    TESTING_EQUAL(delegate->mTotalReceived, 6);
+
+    // releasing the last reference to a socket from within its handler must
+    // not wait upon the monitor thread making the call
+    MisbehavingSocketPtr releasing = std::make_shared<MisbehavingSocket>();
+    releasing->mSocket = zsLib::Socket::createUDP();
+    releasing->mSocket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+    releasing->mSocket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+    releasing->mSocket->monitor(zsLib::Socket::Monitor::Read);
+    releasing->mSocket->setDirectDelegate(releasing);
+
+    sender->sendTo(releasing->mSocket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    TESTING_SLEEP(200)
+    TESTING_EQUAL(releasing->mTotalCalled, 1);
+
+    sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    TESTING_SLEEP(200)
+    TESTING_EQUAL(delegate->mTotalReceived, 7);
+
+    // a gone direct delegate stops the socket from being monitored
+    delegate.reset();
+    sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    TESTING_SLEEP(500)
+
+    size_t notifications = socket->getStatistics().mReadReadyNotifications;
+    sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+    TESTING_SLEEP(500)
+    TESTING_EQUAL(socket->getStatistics().mReadReadyNotifications, notifications);
+
+    throwingSocket->close();
+    socket->close();
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS);
+  }
+
+  //---------------------------------------------------------------------------
+  static void testIdleTimeout()
+  {
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      DrainingSocketPtr idleDelegate = DrainingSocket::create(thread);
+      DrainingSocketPtr busyDelegate = DrainingSocket::create(thread);
+
+      // set before monitoring begins
+      zsLib::SocketPtr idle = zsLib::Socket::createUDP();
+      idle->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      idle->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      idle->monitor(zsLib::Socket::Monitor::Read);
+      idle->setIdleTimeout(zsLib::Milliseconds(200));
+      idle->setDelegate(idleDelegate);
+      TESTING_CHECK(zsLib::Milliseconds(200) == idle->getIdleTimeout());
+
+      // set while already monitored
+      zsLib::SocketPtr busy = zsLib::Socket::createUDP();
+      busy->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      busy->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      busy->monitor(zsLib::Socket::Monitor::Read);
+      busy->setDelegate(busyDelegate);
+      busy->setIdleTimeout(zsLib::Milliseconds(400));
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      for (size_t index = 0; index < 20; ++index) {
+        sender->sendTo(busy->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+        TESTING_SLEEP(50)
+      }
+
+      TESTING_CHECK(idleDelegate->mIdleTimeoutCalled >= 3);         // ~1000ms idle at 200ms per notification
+      TESTING_CHECK(idleDelegate->mIdleTimeoutCalled <= 5);
+      TESTING_EQUAL(busyDelegate->mIdleTimeoutCalled, 0);
+      TESTING_EQUAL(busyDelegate->mTotalReceived, 20);
+
+      TESTING_SLEEP(700)
+      TESTING_CHECK(busyDelegate->mIdleTimeoutCalled >= 1);         // traffic stopped
+
+      idle->setIdleTimeout();
+      TESTING_SLEEP(100)
+      size_t total = idleDelegate->mIdleTimeoutCalled;
+      TESTING_SLEEP(500)
+      TESTING_EQUAL(idleDelegate->mIdleTimeoutCalled, total);
+
+      idle->close();
+      busy->close();
+    }
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static const zsLib::Socket::MonitorLoad *findBusyPollLoad(
+                                                           const zsLib::Socket::MonitorLoadList &loads,
+                                                           int cpu
+                                                           )
+  {
+    for (auto iter = loads.begin(); iter != loads.end(); ++iter) {
+      auto &load = (*iter);
+      if ((load.mBusyPoll) && (cpu == load.mBusyPollCPU)) return &load;
+    }
+    return NULL;
+  }
+
+  //---------------------------------------------------------------------------
+  static void testBusyPoll()
+  {
+    DirectSocketPtr delegate = std::make_shared<DirectSocket>();
+    DirectSocketPtr idleDelegate = std::make_shared<DirectSocket>();
+
+    {
+      // always spins on its pinned thread
+      zsLib::Socket::BusyPollOptions options;
+      options.mCPU = 0;
+
+      zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+      socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      socket->setBusyPoll(options);
+      socket->monitor(zsLib::Socket::Monitor::Read);
+      socket->setDirectDelegate(delegate);
+
+      // stops spinning once idle
+      zsLib::Socket::BusyPollOptions idleOptions;
+      idleOptions.mKernelBusyPoll = zsLib::Microseconds();
+      idleOptions.mSpinTimeout = zsLib::Microseconds(1000);
+
+      zsLib::SocketPtr idle = zsLib::Socket::createUDP();
+      idle->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      idle->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      idle->setBusyPoll(idleOptions);
+      idle->monitor(zsLib::Socket::Monitor::Read);
+      idle->setDirectDelegate(idleDelegate);
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      for (size_t index = 0; index < 5; ++index) {
+        sender->sendTo(socket->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+        sender->sendTo(idle->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mTotalReceived, 5);
+      TESTING_EQUAL(idleDelegate->mTotalReceived, 5);
+
+      auto loads = zsLib::Socket::getMonitorLoads();
+      const zsLib::Socket::MonitorLoad *spinning = findBusyPollLoad(loads, 0);
+      const zsLib::Socket::MonitorLoad *idling = findBusyPollLoad(loads, -1);
+      TESTING_CHECK(spinning);
+      TESTING_CHECK(idling);
+      if ((spinning) && (idling)) {
+        TESTING_EQUAL(spinning->mTotalSockets, 1);
+        TESTING_CHECK(spinning->mTotalSpinWaits > 0);
+        TESTING_CHECK(spinning->mThreadCPUTime > zsLib::Microseconds());
+        TESTING_CHECK(spinning->mThreadRunTime > zsLib::Microseconds());
+
+        size_t idleSpinWaits = idling->mTotalSpinWaits;
+
+        TESTING_SLEEP(300)
+
+        loads = zsLib::Socket::getMonitorLoads();
+        idling = findBusyPollLoad(loads, -1);
+        TESTING_CHECK(idling);
+        if (idling) {
+          TESTING_EQUAL(idling->mTotalSpinWaits, idleSpinWaits);    // asleep until a socket fires again
+        }
+      }
+
+      socket->close();
+      idle->close();
+    }
+  }
+
+  //---------------------------------------------------------------------------
+  static void testPendingRegistrations()
+  {
+    zsLib::ISettings::setUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS, 1);     // every socket shares the stalled monitor
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      StallingSocketPtr stall = std::make_shared<StallingSocket>();
+      DrainingSocketPtr rearmedDelegate = DrainingSocket::create(thread);
+      DrainingSocketPtr reusedDelegate = DrainingSocket::create(thread);
+
+      zsLib::SocketPtr stalled = zsLib::Socket::createUDP();
+      stalled->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      stalled->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      stalled->monitor(zsLib::Socket::Monitor::Read);
+      stalled->setDirectDelegate(stall);
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      sender->sendTo(stalled->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+
+      while (!stall->mStalled) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      // monitorEnd then monitorBegin queue the same handle twice
+      zsLib::SocketPtr rearmed = zsLib::Socket::createUDP();
+      rearmed->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      rearmed->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      rearmed->setDelegate(rearmedDelegate);
+      rearmed->monitor(zsLib::Socket::Monitor::Options(zsLib::Socket::Monitor::Read | zsLib::Socket::Monitor::Exception));
+
+      // a handle closed while pending is reused by a new socket
+      zsLib::SocketPtr closed = zsLib::Socket::createUDP();
+      closed->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      closed->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      closed->setDelegate(DrainingSocket::create(thread));
+      SOCKET closedHandle = closed->getSocket();
+      closed->close();
+
+      zsLib::SocketPtr reused = zsLib::Socket::createUDP();
+      TESTING_EQUAL(reused->getSocket(), closedHandle);
+      reused->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      reused->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      reused->setDelegate(reusedDelegate);
+
+      stall->mRelease = true;
+      TESTING_SLEEP(200)
+
+      sender->sendTo(rearmed->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      sender->sendTo(reused->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(rearmedDelegate->mTotalReceived, 1);
+      TESTING_EQUAL(reusedDelegate->mTotalReceived, 1);
+
+      stalled->close();
+      rearmed->close();
+      reused->close();
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS);
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static size_t getMonitorWakeUps()
+  {
+    auto loads = zsLib::Socket::getMonitorLoads();
+    for (auto iter = loads.begin(); iter != loads.end(); ++iter) {
+      if (0 != (*iter).mTotalSockets) return (*iter).mTotalWakeUps;
+    }
+    return 0;
+  }
+
+  //---------------------------------------------------------------------------
+  static void testWakeUp(bool disableEventFD)
+  {
+    zsLib::ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_DISABLE_EVENTFD, disableEventFD);   // read when the monitor creates its wake-up descriptor
+    zsLib::ISettings::setUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS, 0);             // on demand monitors are created afresh and shut down once empty
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      StallingSocketPtr stall = std::make_shared<StallingSocket>();
+      DrainingSocketPtr delegate = DrainingSocket::create(thread);
+
+      zsLib::SocketPtr stalled = zsLib::Socket::createUDP();
+      stalled->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      stalled->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      stalled->monitor(zsLib::Socket::Monitor::Read);
+      stalled->setDirectDelegate(stall);
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      sender->sendTo(stalled->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+
+      while (!stall->mStalled) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+      size_t wakeUpsBefore = getMonitorWakeUps();
+
+      // every registration wakes the monitor but only the first wake-up is
+      // signalled until the monitor thread consumes it
+      std::vector<zsLib::SocketPtr> sockets;
+      for (size_t index = 0; index < 50; ++index) {
+        zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+        socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+        socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+        socket->setDelegate(delegate);
+        sockets.push_back(socket);
+      }
+
+      size_t wakeUpsStalled = getMonitorWakeUps() - wakeUpsBefore;
+      TESTING_CHECK(wakeUpsStalled <= 1)
+
+      stall->mRelease = true;
+      TESTING_SLEEP(200)
+
+      // the coalesced wake-up applied every registration
+      for (auto iter = sockets.begin(); iter != sockets.end(); ++iter) {
+        sender->sendTo((*iter)->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mTotalReceived, 50);
+
+      // the wake-up descriptor is re-armed once consumed
+      size_t wakeUpsAfter = getMonitorWakeUps();
+      zsLib::SocketPtr late = zsLib::Socket::createUDP();
+      late->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      late->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      late->setDelegate(delegate);
+      TESTING_SLEEP(100)
+      TESTING_CHECK(getMonitorWakeUps() > wakeUpsAfter)
+
+      sender->sendTo(late->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      TESTING_SLEEP(200)
+      TESTING_EQUAL(delegate->mTotalReceived, 51);
+
+      for (auto iter = sockets.begin(); iter != sockets.end(); ++iter) {
+        (*iter)->close();
+      }
+      late->close();
+      stalled->close();
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS);
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_DISABLE_EVENTFD);
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void testCompletionEngine(const char *engine)
+  {
+    zsLib::ISettings::setString(ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE, engine);
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      CompletionSocketPtr delegate = CompletionSocket::create(thread);
+
+      zsLib::SocketPtr receiver = zsLib::Socket::createUDP();
+      receiver->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+      receiver->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      receiver->setCompletionDelegate(delegate);
+
+      TESTING_STDOUT() << "COMPLETION ENGINE: requested " << engine << ", using " << receiver->getCompletionEngineName() << "\n";
+      if (zsLib::String("readiness") == engine) {
+        TESTING_EQUAL(receiver->getCompletionEngineName(), "readiness");
+      } else {
+        TESTING_CHECK(receiver->getCompletionEngineName().hasData());
+      }
+
+      BYTE buffers[3][64] {};
+      for (size_t index = 0; index < 3; ++index) {
+        receiver->submitReceive(&(buffers[index][0]), sizeof(buffers[index]));
+      }
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      sender->setCompletionDelegate(delegate);
+      sender->connect(receiver->getLocalAddress());
+      sender->submitSend((const BYTE *)"HELLO", sizeof("HELLO"));
+      sender->submitSend((const BYTE *)"HELLO", sizeof("HELLO"));
+
+      TESTING_SLEEP(1000)
+
+      TESTING_EQUAL(delegate->mReceived, 2);
+      TESTING_EQUAL(delegate->mBytesReceived, sizeof("HELLO") * 2);
+      TESTING_EQUAL(delegate->mBytesSent, sizeof("HELLO") * 2);
+      TESTING_EQUAL(delegate->mErrors, 0);
+
+      receiver->close();                                              // the outstanding receive is cancelled
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mErrors, 1);
+
+      zsLib::SocketPtr listener = zsLib::Socket::createTCP();
+      listener->setOptionFlag(zsLib::Socket::SetOptionFlag::ReuseAddress, true);
+      listener->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+      listener->listen();
+      listener->setCompletionDelegate(delegate);
+      listener->submitAccept();
+
+      zsLib::SocketPtr client = zsLib::Socket::createTCP();
+      client->connect(listener->getLocalAddress());
+
+      TESTING_SLEEP(500)
+
+      TESTING_EQUAL(delegate->mAccepted, 1);
+      TESTING_CHECK(delegate->mAcceptedSocket)
+      if (delegate->mAcceptedSocket) {
+        TESTING_CHECK(delegate->mAcceptedSocket->getRemoteAddress() == client->getLocalAddress());
+        delegate->mAcceptedSocket.reset();
+      }
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_COMPLETION_ENGINE);
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void testReactors()
+  {
+    zsLib::ISettings::setUInt(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS, 2);
+    zsLib::ISettings::setString(ZSLIB_SETTING_SOCKET_MONITOR_ASSIGNMENT, "hash");
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      BenchmarkSocketPtr delegate = BenchmarkSocket::create(thread);
+
+      std::vector<zsLib::SocketPtr> sockets;
+      for (size_t index = 0; index < 10; ++index) {
+        zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+        socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+        socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+        socket->setDelegate(delegate);
+        sockets.push_back(socket);
+      }
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      for (auto iter = sockets.begin(); iter != sockets.end(); ++iter) {
+        sender->sendTo((*iter)->getLocalAddress(), (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      TESTING_SLEEP(2000)
+
+      TESTING_EQUAL(delegate->mReadReadyCalled, 10);
+
+      auto loads = zsLib::Socket::getMonitorLoads();
+
+      size_t totalReactors = 0;
+      size_t totalSockets = 0;
+      size_t totalEvents = 0;
+      size_t totalActiveWaits = 0;
+      size_t maxEventsPerWait = 0;
+      for (auto iter = loads.begin(); iter != loads.end(); ++iter) {
+        auto &load = (*iter);
+        if (!load.mReactor) continue;
+        ++totalReactors;
+        totalSockets += load.mTotalSockets;
+        totalEvents += load.mTotalEvents;
+        totalActiveWaits += load.mTotalActiveWaits;
+        if (load.mMaxEventsPerWait > maxEventsPerWait) maxEventsPerWait = load.mMaxEventsPerWait;
+      }
+
+      TESTING_EQUAL(totalReactors, 2);
+      TESTING_EQUAL(totalSockets, 11);   // includes the sender
+      TESTING_CHECK(totalEvents >= 10);
+      TESTING_CHECK(totalActiveWaits > 0);
+      TESTING_CHECK(totalActiveWaits <= totalEvents);
+      TESTING_CHECK(maxEventsPerWait >= 1);
+
+      size_t readReady = 0;
+      for (auto iter = sockets.begin(); iter != sockets.end(); ++iter) {
+        readReady += (*iter)->getStatistics().mReadReadyNotifications;
+      }
+      TESTING_EQUAL(readReady, 10);
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_TOTAL_REACTORS);
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_ASSIGNMENT);
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void benchmarkSocketMonitor(size_t totalSockets)
+  {
+    typedef std::chrono::steady_clock BenchmarkClock;
+
+#ifndef _WIN32
+    {
+      struct rlimit limit {};
+      if (0 == getrlimit(RLIMIT_NOFILE, &limit)) {
+        if (limit.rlim_cur < totalSockets + 1024) {
+          limit.rlim_cur = (limit.rlim_max < totalSockets + 1024 ? limit.rlim_max : totalSockets + 1024);
+          setrlimit(RLIMIT_NOFILE, &limit);
+          getrlimit(RLIMIT_NOFILE, &limit);
+        }
+        // leave head room for the monitor threads and their wake-up sockets
+        if (limit.rlim_cur < totalSockets + 1024) {
+          totalSockets = (limit.rlim_cur > 1024 ? static_cast<size_t>(limit.rlim_cur) - 1024 : 0);
+        }
+      }
+    }
+#endif //ndef _WIN32
+
+    if (0 == totalSockets) return;
+
+    zsLib::IMessageQueueThreadPtr thread(zsLib::IMessageQueueThread::createBasic());
+
+    {
+      BenchmarkSocketPtr delegate = BenchmarkSocket::create(thread);
+
+      std::vector<zsLib::SocketPtr> sockets;
+      std::vector<zsLib::IPAddress> addresses;
+      sockets.reserve(totalSockets);
+      addresses.reserve(totalSockets);
+
+      auto start = BenchmarkClock::now();
+      for (size_t index = 0; index < totalSockets; ++index) {
+        zsLib::SocketPtr socket = zsLib::Socket::createUDP();
+        socket->setOptionFlag(zsLib::Socket::SetOptionFlag::NonBlocking, true);
+        socket->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+        socket->setDelegate(delegate);
+        addresses.push_back(socket->getLocalAddress());
+        sockets.push_back(socket);
+      }
+      auto monitored = BenchmarkClock::now();
+
+      zsLib::SocketPtr sender = zsLib::Socket::createUDP();
+      sender->bind(zsLib::IPAddress(zsLib::IPAddress::loopbackV4(), 0));
+
+      size_t totalReady = (sockets.size() < ZSLIB_TEST_SOCKET_BENCHMARK_TOTAL_READY ? sockets.size() : ZSLIB_TEST_SOCKET_BENCHMARK_TOTAL_READY);
+
+      auto sent = BenchmarkClock::now();
+      for (size_t index = 0; index < totalReady; ++index) {
+        size_t which = (index * (sockets.size() / totalReady));
+        sender->sendTo(addresses[which], (BYTE *)"HELLO", sizeof("HELLO"));
+      }
+
+      while (delegate->mReadReadyCalled < totalReady) {
+        if (BenchmarkClock::now() - sent > zsLib::Seconds(60)) break;
+        std::this_thread::yield();
+      }
+      auto received = BenchmarkClock::now();
+
+      TESTING_EQUAL(delegate->mReadReadyCalled, totalReady);
+
+      size_t totalMonitors = 0;
+      auto loads = zsLib::Socket::getMonitorLoads();
+      for (auto iter = loads.begin(); iter != loads.end(); ++iter) {
+        if (0 != (*iter).mTotalSockets) ++totalMonitors;
+      }
+
+#ifdef __linux__
+      // epoll backed monitors are not capped at FD_SETSIZE so every socket shares one monitor thread
+      if (zsLib::ISettings::getBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL)) {
+        TESTING_EQUAL(totalMonitors, 1);
+      }
+#endif //__linux__
+
+      TESTING_STDOUT() << "BENCHMARK:    monitored " << sockets.size() << " sockets (epoll=" << zsLib::ISettings::getBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL) << ") on " << totalMonitors << " monitor(s) in " << std::chrono::duration_cast<zsLib::Milliseconds>(monitored - start).count() << "ms\n";
+      TESTING_STDOUT() << "BENCHMARK:    delivered " << delegate->mReadReadyCalled << " read ready notifications in " << std::chrono::duration_cast<zsLib::Microseconds>(received - sent).count() << "us\n";
+
+      sockets.clear();
+    }
+
+    IMessageQueue::size_type count = 0;
+    do
+    {
+      count = thread->getTotalUnprocessedMessages();
+      if (0 != count)
+        std::this_thread::yield();
+    } while (count > 0);
+    thread->waitForShutdown();
+  }
+
+  //---------------------------------------------------------------------------
+  static void benchmarkSocketMonitor()
+  {
+    if (!ZSLIB_TEST_SOCKET_BENCHMARK) return;
+
+    const size_t totals[] = {10000, 100000};
+
+    for (size_t index = 0; index < sizeof(totals) / sizeof(totals[0]); ++index) {
+      zsLib::ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL, false);
+      benchmarkSocketMonitor(totals[index]);
+      zsLib::ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL, true);
+      benchmarkSocketMonitor(totals[index]);
+    }
+
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL);
+  }
+
   class SocketTest
   {
   public:
@@ -308,5 +1417,29 @@ void testSocketAsync()
 {
   if (!ZSLIB_TEST_SOCKET_ASYNC) return;
 
+  {
+    async_socket::SocketTest test;
+  }
+
+  // repeat using the epoll based socket monitor (where available)
+  {
+    zsLib::ISettings::setBool(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL, true);
     async_socket::SocketTest test;
+    zsLib::ISettings::clear(ZSLIB_SETTING_SOCKET_MONITOR_USE_EPOLL);
+  }
+
+  async_socket::testEdgeTriggered(false);
+  async_socket::testEdgeTriggered(true);
+  async_socket::testZeroCopy();
+  async_socket::testReceiveIntoPool();
+  async_socket::testDirectDelegate();
+  async_socket::testIdleTimeout();
+  async_socket::testBusyPoll();
+  async_socket::testPendingRegistrations();
+  async_socket::testWakeUp(false);
+  async_socket::testWakeUp(true);       // the pipe used where eventfd is unavailable
+  async_socket::testCompletionEngine("readiness");
+  async_socket::testCompletionEngine("io_uring");
+  async_socket::testReactors();
+  async_socket::benchmarkSocketMonitor();
 }
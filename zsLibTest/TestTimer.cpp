@@ -35,6 +35,10 @@
 #include "testing.h"
 #include "main.h"
 
+#include <vector>
+
+#define ZSLIB_TEST_TIMER_BENCHMARK_TOTAL_TIMERS (1000000)
+
 using zsLib::ULONG;
 using zsLib::IMessageQueue;
 
@@ -55,6 +59,7 @@ public:
 
   virtual void onTimer(zsLib::ITimerPtr timer)
   {
+    if (0 == mCount) mFirstFiredAt = zsLib::steadyNow();
     ++mCount;
     TESTING_STDOUT() << "ONTIMER:      " << ((zsLib::PTRNUMBER)timer.get()) << "\n";
   }
@@ -65,36 +70,190 @@ public:
 
 public:
   ULONG mCount;
+  zsLib::SteadyTime mFirstFiredAt {};
 };
 
+ZS_DECLARE_CLASS_PTR(TestTimerBenchmarkCallback)
 
-void testTimer()
+class TestTimerBenchmarkCallback : public zsLib::ITimerDelegate,
+                                   public zsLib::MessageQueueAssociator
 {
-  if (!ZSLIB_TEST_TIMER) return;
+private:
+  TestTimerBenchmarkCallback(zsLib::IMessageQueuePtr queue) : zsLib::MessageQueueAssociator(queue)
+  {
+  }
+public:
+  static TestTimerBenchmarkCallbackPtr create(zsLib::IMessageQueuePtr queue)
+  {
+    return TestTimerBenchmarkCallbackPtr(new TestTimerBenchmarkCallback(queue));
+  }
+
+  virtual void onTimer(zsLib::ITimerPtr timer)
+  {
+    ++mCount;
+  }
+
+public:
+  std::atomic<size_t> mCount {};
+};
+
+static void testTimerBenchmark()
+{
+  if (!ZSLIB_TEST_TIMER_BENCHMARK) return;
+
+  typedef std::chrono::steady_clock BenchmarkClock;
+
+  const size_t total = ZSLIB_TEST_TIMER_BENCHMARK_TOTAL_TIMERS;
 
   auto thread(zsLib::IMessageQueueThread::createBasic());
 
+  {
+    TestTimerBenchmarkCallbackPtr testObject = TestTimerBenchmarkCallback::create(thread);
+
+    std::vector<zsLib::ITimerPtr> timers;
+    timers.reserve(total);
+
+    // scope: arm timers which expire over a two second window
+    auto start = BenchmarkClock::now();
+    for (size_t index = 0; index < total; ++index) {
+      timers.push_back(zsLib::ITimer::create(testObject, zsLib::Milliseconds(1000 + (index % 2000)), false));
+    }
+    auto armed = BenchmarkClock::now();
+
+    while (testObject->mCount < total) {
+      if (BenchmarkClock::now() - armed > zsLib::Seconds(60)) break;
+      TESTING_SLEEP(10)
+    }
+    auto fired = BenchmarkClock::now();
+
+    TESTING_EQUAL(testObject->mCount, total);
+
+    TESTING_STDOUT() << "BENCHMARK:    armed " << total << " timers in " << std::chrono::duration_cast<zsLib::Milliseconds>(armed - start).count() << "ms\n";
+    TESTING_STDOUT() << "BENCHMARK:    fired " << testObject->mCount << " timers " << std::chrono::duration_cast<zsLib::Milliseconds>(fired - armed).count() << "ms after arming completed\n";
+
+    timers.clear();
+  }
+
+  {
+    TestTimerBenchmarkCallbackPtr testObject = TestTimerBenchmarkCallback::create(thread);
+
+    std::vector<zsLib::ITimerPtr> timers;
+    timers.reserve(total);
+
+    // scope: arm and cancel long running timers which never fire
+    for (size_t index = 0; index < total; ++index) {
+      timers.push_back(zsLib::ITimer::create(testObject, zsLib::Seconds(60 + (index % 60))));
+    }
+
+    // background timers ticking while the monitor holds a large idle set
+    zsLib::ITimerPtr ticker = zsLib::ITimer::create(testObject, zsLib::Milliseconds(10));
+    TESTING_SLEEP(1000)
+    ticker->cancel();
+
+    auto start = BenchmarkClock::now();
+    for (auto iter = timers.begin(); iter != timers.end(); ++iter) {
+      (*iter)->cancel();
+    }
+    auto cancelled = BenchmarkClock::now();
+
+    TESTING_CHECK(testObject->mCount > 50);
+
+    TESTING_STDOUT() << "BENCHMARK:    ticker fired " << testObject->mCount << " times in 1000ms with " << total << " idle timers\n";
+    TESTING_STDOUT() << "BENCHMARK:    cancelled " << total << " timers in " << std::chrono::duration_cast<zsLib::Milliseconds>(cancelled - start).count() << "ms\n";
+
+    timers.clear();
+  }
+
+  IMessageQueue::size_type count = 0;
+  do
+  {
+    count = thread->getTotalUnprocessedMessages();
+    if (0 != count)
+      std::this_thread::yield();
+  } while (count > 0);
+  thread->waitForShutdown();
+}
+
+
+static void testTimerPass()
+{
+  auto thread(zsLib::IMessageQueueThread::createBasic());
+
   TestTimerCallbackPtr testObject = TestTimerCallback::create(thread);
   TestTimerCallbackPtr testObject2 = TestTimerCallback::create(thread);
   TestTimerCallbackPtr testObject3 = TestTimerCallback::create(thread);
   TestTimerCallbackPtr testObject4 = TestTimerCallback::create(thread);
+  TestTimerCallbackPtr testObject5 = TestTimerCallback::create(thread);
+  TestTimerCallbackPtr testObject6 = TestTimerCallback::create(thread);
+  TestTimerBenchmarkCallbackPtr testObject7 = TestTimerBenchmarkCallback::create(thread);
+  TestTimerCallbackPtr testObject8 = TestTimerCallback::create(thread);
+
+  zsLib::SteadyTime start = zsLib::steadyNow();
 
   zsLib::ITimerPtr timer1(zsLib::ITimer::create(testObject, zsLib::Seconds(3)));
   zsLib::ITimerPtr timer2(zsLib::ITimer::create(testObject2, zsLib::Seconds(1), false));
   zsLib::ITimerPtr timer3(zsLib::ITimer::create(testObject3, zsLib::Seconds(4), false));
   zsLib::ITimerPtr timer4(zsLib::ITimer::create(testObject4, zsLib::Seconds(4), false));
+  zsLib::ITimerPtr timer5(zsLib::ITimer::create(testObject5, zsLib::Milliseconds(2800), false, ZSLIB_MAX_TIMER_FIRED_AT_ONCE, zsLib::Milliseconds(500)));   // tolerance overlaps the first firing of timer1 and timer6
+  zsLib::ITimerPtr timer6(zsLib::ITimer::create(testObject6, zsLib::Seconds(3), true, ZSLIB_MAX_TIMER_FIRED_AT_ONCE, zsLib::Milliseconds(500)));
+  zsLib::ITimerPtr timer8(zsLib::ITimer::create(testObject8, zsLib::steadyNow() + zsLib::Seconds(2)));
 
   timer3.reset();         // this should cause the timer to be cancelled as if it fell out of scope before it has a chance to fire
   timer4->background();   // this should cause the timer to not be cancelled (but it will cancel itself after being fired)
   timer4.reset();
 
+  // many timers expiring together on the same queue are delivered as a batch
+  for (int index = 0; index < 100; ++index) {
+    zsLib::ITimer::create(testObject7, zsLib::Seconds(2), false, ZSLIB_MAX_TIMER_FIRED_AT_ONCE, zsLib::Milliseconds(100))->background();
+  }
+
+  // timers on other queues (assigned to different shards when sharded)
+  std::vector<zsLib::IMessageQueueThreadPtr> otherThreads;
+  std::vector<TestTimerBenchmarkCallbackPtr> otherObjects;
+  std::vector<zsLib::ITimerPtr> otherTimers;
+  for (int index = 0; index < 8; ++index) {
+    otherThreads.push_back(zsLib::IMessageQueueThread::createBasic());
+    otherObjects.push_back(TestTimerBenchmarkCallback::create(otherThreads.back()));
+    otherTimers.push_back(zsLib::ITimer::create(otherObjects.back(), zsLib::Seconds(1), false));
+    otherTimers.push_back(zsLib::ITimer::create(otherObjects.back(), zsLib::Seconds(1)));
+  }
+  otherTimers.back()->cancel();     // cancelling on one shard does not affect the others
+
   TESTING_SLEEP(10000)
   timer1->cancel();
+  timer6->cancel();
+
+  for (size_t index = 0; index < otherObjects.size(); ++index) {
+    otherTimers[(index * 2) + 1]->cancel();
+    if (index + 1 == otherObjects.size()) {
+      TESTING_EQUAL(otherObjects[index]->mCount, 1);
+    } else {
+      TESTING_CHECK(otherObjects[index]->mCount >= 9);
+    }
+  }
+  otherTimers.clear();
+  otherObjects.clear();
+  for (auto iter = otherThreads.begin(); iter != otherThreads.end(); ++iter) {
+    (*iter)->waitForShutdown();
+  }
+  otherThreads.clear();
 
   TESTING_EQUAL(testObject->mCount, 3);
   TESTING_EQUAL(testObject2->mCount, 1);
   TESTING_EQUAL(testObject3->mCount, 0);
   TESTING_EQUAL(testObject4->mCount, 1);
+  TESTING_EQUAL(testObject5->mCount, 1);
+  TESTING_EQUAL(testObject6->mCount, 3);
+  TESTING_EQUAL(testObject7->mCount, 100);
+  TESTING_EQUAL(testObject8->mCount, 1);
+
+  // timer5 was held back (within its tolerance) to share timer6's wake-up
+  // rather than waking the monitor 200ms earlier on its own
+  auto timer5FiredAfter = std::chrono::duration_cast<zsLib::Milliseconds>(testObject5->mFirstFiredAt - start);
+  auto timer5And6Apart = std::chrono::duration_cast<zsLib::Milliseconds>(testObject6->mFirstFiredAt - testObject5->mFirstFiredAt);
+  TESTING_CHECK(timer5FiredAfter >= zsLib::Milliseconds(2950))
+  TESTING_CHECK(timer5And6Apart.count() < 50)
+  TESTING_CHECK(timer5And6Apart.count() > -50)
 
   TESTING_STDOUT() << "WAITING:      To ensure the timers have truly stopped firing events.\n";
   TESTING_SLEEP(10000)
@@ -103,11 +262,16 @@ void testTimer()
   timer2.reset();
   timer3.reset();
   timer4.reset();
+  timer5.reset();
+  timer6.reset();
+  timer8.reset();
 
   TESTING_EQUAL(testObject->mCount, 3);
   TESTING_EQUAL(testObject2->mCount, 1);
   TESTING_EQUAL(testObject3->mCount, 0);
   TESTING_EQUAL(testObject4->mCount, 1);
+  TESTING_EQUAL(testObject5->mCount, 1);
+  TESTING_EQUAL(testObject6->mCount, 3);
 
   IMessageQueue::size_type count = 0;
   do
@@ -120,3 +284,51 @@ void testTimer()
 
   TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
 }
+
+static void testTimerDelegateReleasedWhileQueued()
+{
+  auto thread(zsLib::IMessageQueueThread::createBasic());
+
+  std::atomic<bool> unblock {};
+  thread->postClosure([&unblock]() {
+    while (!unblock) std::this_thread::yield();
+  });
+
+  TestTimerCallbackPtr testObject = TestTimerCallback::create(thread);
+  TestTimerCallbackWeakPtr weakObject = testObject;
+
+  zsLib::ITimerPtr timer(zsLib::ITimer::create(testObject, zsLib::Milliseconds(100), false));
+
+  TESTING_SLEEP(1000)   // the firing is now queued behind the blocked message
+
+  // the queued firing must not keep the delegate alive
+  testObject.reset();
+  TESTING_CHECK(!weakObject.lock())
+
+  unblock = true;
+
+  IMessageQueue::size_type count = 0;
+  do
+  {
+    count = thread->getTotalUnprocessedMessages();
+    if (0 != count)
+      std::this_thread::yield();
+  } while (count > 0);
+
+  timer->cancel();
+  timer.reset();
+
+  thread->waitForShutdown();
+
+  TESTING_EQUAL(zsLib::proxyGetTotalConstructed(), 0);
+}
+
+void testTimer()
+{
+  if (!ZSLIB_TEST_TIMER) return;
+
+  testTimerPass();
+  testTimerDelegateReleasedWhileQueued();
+
+  testTimerBenchmark();
+}
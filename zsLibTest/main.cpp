@@ -2,9 +2,26 @@
 #include "testing.h"
 
 #include <zsLib/helpers.h>
+#include <zsLib/ISettings.h>
+#include <zsLib/ITimer.h>
+
+#include <cstring>
+#include <cstdlib>
 
 int main (int argc, char * const argv[]) {
 
+  // the timer monitor reads its configuration once (when the first timer is
+  // created) thus alternative configurations are selected per run
+  for (int index = 1; index < argc; ++index) {
+    const char *arg = argv[index];
+    if (0 == strcmp(arg, "--timerfd")) {
+      zsLib::ISettings::setBool(ZSLIB_SETTING_TIMER_MONITOR_USE_TIMERFD, true);
+    }
+    if (0 == strncmp(arg, "--timer-shards=", strlen("--timer-shards="))) {
+      zsLib::ISettings::setUInt(ZSLIB_SETTING_TIMER_MONITOR_TOTAL_SHARDS, strtoul(arg + strlen("--timer-shards="), NULL, 10));
+    }
+  }
+
   Testing::runAllTests();
   Testing::output();
 
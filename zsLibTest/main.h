@@ -38,8 +38,10 @@
 #define ZSLIB_TEST_RANGE            (true)
 #define ZSLIB_TEST_SOCKET           (true)
 #define ZSLIB_TEST_SOCKET_ASYNC     (true)
+#define ZSLIB_TEST_SOCKET_BENCHMARK (false)
 #define ZSLIB_TEST_STRING           (true)
 #define ZSLIB_TEST_STRINGIZE        (true)
 #define ZSLIB_TEST_TEAR_AWAY        (true)
 #define ZSLIB_TEST_TIMER            (true)
+#define ZSLIB_TEST_TIMER_BENCHMARK  (false)
 #define ZSLIB_TEST_XML              (true)